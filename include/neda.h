@@ -1,5 +1,5 @@
 /*
- * 1.3.0
+ * 1.4.0
  * neda - Dynamic Array library. By nenevictor (shyvikaisinlove)
  *
  * Peace! So, this is my realization of dynamic array library.
@@ -78,8 +78,70 @@
  *               "push_back_empty" and "push_front_empty". Removed basic version
  *               of sort - it is pointless thing. Because of it also functions "swap"
  *               and "basic_swap" was removed. Code was a little refactored.
+ *   17.10.2026: version 1.4.0. Added growth policies for "reserve"
+ *               ("NEDA_BODY_IMPLEMENTATION_GROWTH") and "set_growth_function".
+ *               Added "append_n", "insert_range" and "erase_range".
+ *               "insert", "erase" and "*_front" functions now shift elements
+ *               with one "memmove", if default move function is used.
+ *               "sort" and "quick_sort" now use pattern-defeating quicksort
+ *               (O(n log n) in worst case). "NEDA_QUICK_SORT_MAX_LEVELS" was
+ *               removed. Swap and move functions are used by sorting only,
+ *               if they are not default ones, otherwise elements are moved
+ *               by assignment. "stable_sort", "top_k", "parallel_sort"
+ *               and heap functions always move elements by assignment
+ *               and "memcpy".
+ *               Added "radix_sort" ("NEDA_RADIX_BODY_IMPLEMENTATION") for
+ *               integer and float arrays and "radix_sort_by_<key>".
+ *               Added "parallel_sort" ("NEDA_PARALLEL_BODY_IMPLEMENTATION"),
+ *               it needs "NEDA_PTHREAD".
+ *               Added "NEDA_BODY_IMPLEMENTATION_CMP", which builds comparison
+ *               expression into sort functions.
+ *               Every array can have it's own table of compare, swap and
+ *               move functions ("set_functions"), global callbacks are used,
+ *               if it is not set.
+ *               Added ring-buffer deque ("NEDA_DEQUE_BODY_IMPLEMENTATION")
+ *               with O(1) operations on both ends.
+ *               Added small array ("NEDA_SMALL_HEADER"), which keeps
+ *               few elements inside of struct without heap allocations.
+ *               Added allocators ("init_allocator") and arena allocator
+ *               ("neda_arena").
+ *               Fixed "shrink_to_fit" of empty array, which kept freed data.
+ *               Added "init_in_place" and "destroy" for arrays, which are
+ *               placed on stack or inside of other structs.
+ *               Added binary search: "lower_bound", "upper_bound",
+ *               "equal_range", "insert_sorted" and search in Eytzinger
+ *               layout ("eytzinger_build", "eytzinger_lower_bound").
+ *               "memset", "fill" and "copy" now use "memset" and "memcpy".
+ *               Added "find", "count", "sum", "min" and "max" for numbers
+ *               ("NEDA_NUMERIC_BODY_IMPLEMENTATION"), with AVX2 dispatch
+ *               under "NEDA_SIMD".
+ *               Added "stable_sort", adaptive merge sort with galloping,
+ *               it's scratch is taken from allocator of array.
+ *               Added "nth_element", "partial_sort", "top_k" and
+ *               "top_k_push". Added "percentile" for numbers.
+ *               Added "remove_if", "unique" and "retain_indices", which
+ *               compact array in one pass.
+ *               Added file-backed arrays ("NEDA_MAPPED_BODY_IMPLEMENTATION",
+ *               "neda_mapping"), they need "NEDA_MMAP".
+ *               Added binary snapshots "save" and "load"
+ *               ("NEDA_SNAPSHOT_BODY_IMPLEMENTATION") and read-only
+ *               mapping of snapshot "open_mapped".
+ *               Reserve math is integer-only, "nedasize_t" can be
+ *               "size_t" for arrays bigger than 2^32 elements.
+ *               Added lock-free queues "neda_spsc_" and "neda_mpmc_"
+ *               ("NEDA_SPSC_BODY_IMPLEMENTATION",
+ *               "NEDA_MPMC_BODY_IMPLEMENTATION"), they need "NEDA_ATOMIC".
+ *               Added concurrent append-only array "neda_segmented_"
+ *               ("NEDA_SEGMENTED_BODY_IMPLEMENTATION").
+ *               Added struct-of-arrays generator "NEDA_SOA_HEADER",
+ *               "NEDA_SOA_BODY_IMPLEMENTATION".
+ *               Added heap functions "make_heap", "heap_push", "heap_pop",
+ *               "heap_top" and indexed heap "neda_iheap_" with
+ *               "decrease_key" ("NEDA_HEAP_BODY_IMPLEMENTATION_ARITY").
+ *               Added packed bitset "neda_bitset" with word-wise
+ *               operations, "count", "find_next", "rank" and "select".
  * 
- * Optimized quick_sort was stolen from here: https://alienryderflex.com/quicksort/
+ * Sort engine is based on pdqsort by Orson Peters: https://github.com/orlp/pdqsort
  *                 
  */
 
@@ -120,6 +182,26 @@ extern "C"
 #define NEDA_API NEDA_INLINE
 #define NEDA_API_NO_INLINE
 
+#if defined(__GNUC__) || defined(__clang__)
+#define NEDA_MAYBE_UNUSED __attribute__((unused))
+#else
+#define NEDA_MAYBE_UNUSED
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NEDA_PREFETCH(_address) __builtin_prefetch(_address)
+#else
+#define NEDA_PREFETCH(_address)
+#endif
+
+/* Helpers, which are used only by generated functions. */
+#define NEDA_INTERNAL static NEDA_MAYBE_UNUSED
+
+/* Functions, which do not depend on element type. They are defined in
+ * every translation unit, which includes library.
+ */
+#define NEDA_COMMON static NEDA_MAYBE_UNUSED
+
 #if !defined(NEDA_MALLOC) || !defined(NEDA_REALLOC) || !defined(NEDA_FREE)
 #include <malloc.h>
 #endif
@@ -136,6 +218,8 @@ extern "C"
 #define NEDA_FREE(_memory) free(_memory)
 #endif
 
+#include <string.h>
+
 #if !defined(NEDA_ASSERT)
 
 #if defined(_DEBUG) || defined(DEBUG) || !defined(NDEBUG)
@@ -149,30 +233,1735 @@ extern "C"
 
 #define NEDA_UNUSED(_value) (void)(_value)
 
+/* Results of functions, which can fail because of system. */
+#define NEDA_SUCCESS 0
+#define NEDA_FAILURE 1
+
+/* Type of sizes, capacities and indices. Default "unsigned int" limits
+ * arrays to 2^32 - 1 elements, define it as "size_t" before including
+ * "neda.h" for bigger arrays (all size math is done in nedasize_t and
+ * byte counts are done in size_t):
+ *
+ *   #define nedasize_t size_t
+ *   #include "neda.h"
+ */
 #ifndef nedasize_t
 #define nedasize_t unsigned int
 #endif
 
-#ifndef NEDA_QUICK_SORT_MAX_LEVELS
-#define NEDA_QUICK_SORT_MAX_LEVELS 300
+/* Allocator of array memory. "realloc" gets old size of memory block,
+ * so allocators without block headers (like arena) can copy it.
+ * Array without allocator uses NEDA_MALLOC, NEDA_REALLOC and NEDA_FREE.
+ */
+typedef struct neda_allocator
+{
+  void *(*alloc)(void *_context, size_t _size);
+  void *(*realloc)(void *_context, void *_memory, size_t _old_size, size_t _new_size);
+  void (*free)(void *_context, void *_memory);
+  void *context;
+} neda_allocator;
+
+NEDA_COMMON void *neda_allocate(
+    const struct neda_allocator *_allocator,
+    const size_t _size)
+{
+  if (_allocator)
+  {
+    return _allocator->alloc(_allocator->context, _size);
+  }
+  return NEDA_MALLOC(_size);
+}
+
+NEDA_COMMON void *neda_reallocate(
+    const struct neda_allocator *_allocator,
+    void *_memory,
+    const size_t _old_size,
+    const size_t _new_size)
+{
+  if (_allocator)
+  {
+    return _allocator->realloc(
+        _allocator->context,
+        _memory,
+        _old_size,
+        _new_size);
+  }
+  NEDA_UNUSED(_old_size);
+  return NEDA_REALLOC(_memory, _new_size);
+}
+
+NEDA_COMMON void neda_deallocate(
+    const struct neda_allocator *_allocator,
+    void *_memory)
+{
+  if (_allocator)
+  {
+    _allocator->free(_allocator->context, _memory);
+    return;
+  }
+  NEDA_FREE(_memory);
+}
+
+/* Size of arena block, if arena was initialized with 0 block size. */
+#ifndef NEDA_ARENA_BLOCK_SIZE
+#define NEDA_ARENA_BLOCK_SIZE 65536
+#endif
+
+/* Alignment of every arena allocation. */
+#ifndef NEDA_ARENA_ALIGNMENT
+#define NEDA_ARENA_ALIGNMENT 16
+#endif
+
+#define NEDA_ARENA_ALIGN(_size) (((_size) + NEDA_ARENA_ALIGNMENT - 1) & ~(size_t)(NEDA_ARENA_ALIGNMENT - 1))
+
+typedef struct neda_arena_block
+{
+  struct neda_arena_block *next;
+  size_t capacity, used;
+} neda_arena_block;
+
+/* Bump allocator. Memory is taken from big blocks and is never freed
+ * one by one: "reset" drops all allocations at once and "destroy"
+ * returns blocks to NEDA_FREE. Arrays, which use arena, should not be
+ * used after "reset". Example:
+ *   struct neda_arena arena;
+ *   struct neda_int *da;
+ *   neda_arena__init(&arena, 0);
+ *   neda_int__init_allocator(&da, &arena.allocator);
+ *   ...
+ *   neda_arena__reset(&arena);
+ */
+typedef struct neda_arena
+{
+  struct neda_arena_block *blocks;
+  size_t block_size;
+  void *last;
+  struct neda_allocator allocator;
+} neda_arena;
+
+/* \returns memory of "_size" bytes from current block or from new one. */
+NEDA_COMMON void *neda_arena__alloc(void *_arena, size_t _size)
+{
+  struct neda_arena *arena = (struct neda_arena *)_arena;
+  struct neda_arena_block *block = arena->blocks;
+  const size_t header = NEDA_ARENA_ALIGN(sizeof(struct neda_arena_block));
+  size_t capacity;
+  _size = NEDA_ARENA_ALIGN(_size ? _size : 1);
+  if (!block || block->capacity - block->used < _size)
+  {
+    capacity = arena->block_size > _size ? arena->block_size : _size;
+    block = (struct neda_arena_block *)NEDA_MALLOC(header + capacity);
+    if (!block)
+    {
+      return 0;
+    }
+    block->capacity = capacity;
+    block->used = 0;
+    /* Block of big allocation is linked after current block, so
+       next allocations still use free place of current one. */
+    if (arena->blocks && capacity > arena->block_size)
+    {
+      block->next = arena->blocks->next;
+      arena->blocks->next = block;
+      arena->last = 0;
+      return (unsigned char *)block + header;
+    }
+    block->next = arena->blocks;
+    arena->blocks = block;
+  }
+  arena->last = (unsigned char *)block + header + block->used;
+  block->used += _size;
+  return arena->last;
+}
+
+/* Last allocation is grown in place, if block has place for it,
+ * others are copied to new memory. */
+NEDA_COMMON void *neda_arena__realloc(
+    void *_arena,
+    void *_memory,
+    size_t _old_size,
+    size_t _new_size)
+{
+  struct neda_arena *arena = (struct neda_arena *)_arena;
+  struct neda_arena_block *block = arena->blocks;
+  const size_t header = NEDA_ARENA_ALIGN(sizeof(struct neda_arena_block));
+  size_t offset;
+  void *memory;
+  if (!_memory)
+  {
+    return neda_arena__alloc(_arena, _new_size);
+  }
+  if (_memory == arena->last)
+  {
+    offset = (size_t)((unsigned char *)_memory - (unsigned char *)block) - header;
+    if (block->capacity - offset >= NEDA_ARENA_ALIGN(_new_size))
+    {
+      block->used = offset + NEDA_ARENA_ALIGN(_new_size ? _new_size : 1);
+      return _memory;
+    }
+  }
+  memory = neda_arena__alloc(_arena, _new_size);
+  if (memory)
+  {
+    memcpy(memory, _memory, _old_size < _new_size ? _old_size : _new_size);
+  }
+  return memory;
+}
+
+/* Memory of arena is released only by "reset" and "destroy". */
+NEDA_COMMON void neda_arena__free(void *_arena, void *_memory)
+{
+  NEDA_UNUSED(_arena);
+  NEDA_UNUSED(_memory);
+}
+
+/* "_block_size" is size of memory, which is taken by arena at once. */
+NEDA_COMMON void neda_arena__init(
+    struct neda_arena *_arena,
+    const size_t _block_size)
+{
+  NEDA_ASSERT(_arena);
+  _arena->blocks = 0;
+  _arena->block_size = _block_size ? NEDA_ARENA_ALIGN(_block_size)
+                                   : NEDA_ARENA_BLOCK_SIZE;
+  _arena->last = 0;
+  _arena->allocator.alloc = neda_arena__alloc;
+  _arena->allocator.realloc = neda_arena__realloc;
+  _arena->allocator.free = neda_arena__free;
+  _arena->allocator.context = _arena;
+}
+
+/* Drops all allocations, but keeps first block for next ones. */
+NEDA_COMMON void neda_arena__reset(struct neda_arena *_arena)
+{
+  struct neda_arena_block *block;
+  NEDA_ASSERT(_arena);
+  while (_arena->blocks && _arena->blocks->next)
+  {
+    block = _arena->blocks->next;
+    _arena->blocks->next = block->next;
+    NEDA_FREE(block);
+  }
+  if (_arena->blocks)
+  {
+    _arena->blocks->used = 0;
+  }
+  _arena->last = 0;
+}
+
+NEDA_COMMON void neda_arena__destroy(struct neda_arena *_arena)
+{
+  NEDA_ASSERT(_arena);
+  neda_arena__reset(_arena);
+  NEDA_FREE(_arena->blocks);
+  _arena->blocks = 0;
+}
+
+#ifdef NEDA_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Mapped file grows by steps of this size, so arrays with chunk
+ * growth policy do not remap file on every "reserve". */
+#ifndef NEDA_MMAP_GRANULARITY
+#define NEDA_MMAP_GRANULARITY 1048576
+#endif
+
+/* File, which keeps data of one array ("NEDA_MMAP" should be defined,
+ * POSIX.1-2001 is needed). Data grows by "ftruncate" and "mremap",
+ * if it is available (Linux with "_GNU_SOURCE"), or by new "mmap" of
+ * the same file, so elements are never copied and array can be bigger
+ * than RAM. Mapping keeps only data of array, other allocations of
+ * array (like sort scratch) go to NEDA_MALLOC. Length of file is
+ * rounded up to NEDA_MMAP_GRANULARITY, it is cut to size of array,
+ * when mapping is closed. Example:
+ *   struct neda_mapping mapping;
+ *   struct neda_int da;
+ *   if (neda_int__init_mapped(&da, &mapping, "ints.bin") == NEDA_SUCCESS)
+ *   {
+ *     neda_int__push_back(&da, 1);
+ *     neda_mapping__advise(&mapping, POSIX_MADV_SEQUENTIAL);
+ *     neda_int__close_mapped(&da, &mapping);
+ *   }
+ */
+typedef struct neda_mapping
+{
+  int file;
+  void *address;
+  size_t size;
+  int advice;
+  struct neda_allocator allocator;
+} neda_mapping;
+
+/* Makes mapping and file at least "_size" bytes long. Mapping is
+ * never shrunk. */
+NEDA_COMMON int neda_mapping__resize(
+    struct neda_mapping *_mapping,
+    size_t _size)
+{
+  void *address;
+  _size = (_size + NEDA_MMAP_GRANULARITY - 1) / NEDA_MMAP_GRANULARITY;
+  _size = (_size ? _size : 1) * NEDA_MMAP_GRANULARITY;
+  if (_size <= _mapping->size && _mapping->address)
+  {
+    return NEDA_SUCCESS;
+  }
+  if (ftruncate(_mapping->file, (off_t)_size) != 0)
+  {
+    return NEDA_FAILURE;
+  }
+#ifdef MREMAP_MAYMOVE
+  if (_mapping->address)
+  {
+    address = mremap(
+        _mapping->address,
+        _mapping->size,
+        _size,
+        MREMAP_MAYMOVE);
+  }
+  else
+#endif
+  {
+    address = mmap(
+        0,
+        _size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        _mapping->file,
+        0);
+    /* Old mapping is dropped only after new one is made, so data is
+       still available on failure. */
+    if (address != MAP_FAILED && _mapping->address)
+    {
+      munmap(_mapping->address, _mapping->size);
+    }
+  }
+  if (address == MAP_FAILED)
+  {
+    return NEDA_FAILURE;
+  }
+  _mapping->address = address;
+  _mapping->size = _size;
+  if (_mapping->advice != POSIX_MADV_NORMAL)
+  {
+    posix_madvise(_mapping->address, _mapping->size, _mapping->advice);
+  }
+  return NEDA_SUCCESS;
+}
+
+/* Allocator functions of mapping. Only one buffer is placed in file,
+ * every other one is taken from NEDA_MALLOC. */
+NEDA_COMMON void *neda_mapping__alloc(void *_mapping, size_t _size)
+{
+  struct neda_mapping *mapping = (struct neda_mapping *)_mapping;
+  if (mapping->address)
+  {
+    return NEDA_MALLOC(_size);
+  }
+  return neda_mapping__resize(mapping, _size) == NEDA_SUCCESS
+             ? mapping->address
+             : 0;
+}
+
+NEDA_COMMON void *neda_mapping__realloc(
+    void *_mapping,
+    void *_memory,
+    size_t _old_size,
+    size_t _new_size)
+{
+  struct neda_mapping *mapping = (struct neda_mapping *)_mapping;
+  NEDA_UNUSED(_old_size);
+  if (_memory != mapping->address)
+  {
+    return NEDA_REALLOC(_memory, _new_size);
+  }
+  return neda_mapping__resize(mapping, _new_size) == NEDA_SUCCESS
+             ? mapping->address
+             : 0;
+}
+
+NEDA_COMMON void neda_mapping__free(void *_mapping, void *_memory)
+{
+  struct neda_mapping *mapping = (struct neda_mapping *)_mapping;
+  if (!_memory || _memory != mapping->address)
+  {
+    NEDA_FREE(_memory);
+    return;
+  }
+  munmap(mapping->address, mapping->size);
+  mapping->address = 0;
+  mapping->size = 0;
+}
+
+/* Opens or creates file at "_path" and maps all of it. */
+NEDA_COMMON int neda_mapping__open(
+    struct neda_mapping *_mapping,
+    const char *_path)
+{
+  struct stat status;
+  NEDA_ASSERT(_mapping && _path);
+  _mapping->address = 0;
+  _mapping->size = 0;
+  _mapping->advice = POSIX_MADV_NORMAL;
+  _mapping->allocator.alloc = neda_mapping__alloc;
+  _mapping->allocator.realloc = neda_mapping__realloc;
+  _mapping->allocator.free = neda_mapping__free;
+  _mapping->allocator.context = _mapping;
+  _mapping->file = open(_path, O_RDWR | O_CREAT, 0644);
+  if (_mapping->file < 0)
+  {
+    return NEDA_FAILURE;
+  }
+  if (fstat(_mapping->file, &status) != 0)
+  {
+    close(_mapping->file);
+    return NEDA_FAILURE;
+  }
+  if (status.st_size > 0)
+  {
+    _mapping->address = mmap(
+        0,
+        (size_t)status.st_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        _mapping->file,
+        0);
+    if (_mapping->address == MAP_FAILED)
+    {
+      _mapping->address = 0;
+      close(_mapping->file);
+      return NEDA_FAILURE;
+    }
+    _mapping->size = (size_t)status.st_size;
+  }
+  return NEDA_SUCCESS;
+}
+
+/* Writes changed pages to file. If "_wait" is logical false, writing
+ * is only scheduled. */
+NEDA_COMMON int neda_mapping__flush(
+    struct neda_mapping *_mapping,
+    const int _wait)
+{
+  NEDA_ASSERT(_mapping);
+  if (!_mapping->address)
+  {
+    return NEDA_SUCCESS;
+  }
+  return msync(
+             _mapping->address,
+             _mapping->size,
+             _wait ? MS_SYNC : MS_ASYNC) == 0
+             ? NEDA_SUCCESS
+             : NEDA_FAILURE;
+}
+
+/* Sets "posix_madvise" hint (like POSIX_MADV_SEQUENTIAL before long
+ * scans), it is kept after mapping grows. */
+NEDA_COMMON int neda_mapping__advise(
+    struct neda_mapping *_mapping,
+    const int _advice)
+{
+  NEDA_ASSERT(_mapping);
+  _mapping->advice = _advice;
+  if (!_mapping->address)
+  {
+    return NEDA_SUCCESS;
+  }
+  return posix_madvise(_mapping->address, _mapping->size, _advice) == 0
+             ? NEDA_SUCCESS
+             : NEDA_FAILURE;
+}
+
+/* Unmaps file and cuts it to "_size" bytes. */
+NEDA_COMMON int neda_mapping__close(
+    struct neda_mapping *_mapping,
+    const size_t _size)
+{
+  int result = NEDA_SUCCESS;
+  NEDA_ASSERT(_mapping);
+  if (_mapping->address)
+  {
+    munmap(_mapping->address, _mapping->size);
+    _mapping->address = 0;
+    _mapping->size = 0;
+  }
+  if (ftruncate(_mapping->file, (off_t)_size) != 0)
+  {
+    result = NEDA_FAILURE;
+  }
+  if (close(_mapping->file) != 0)
+  {
+    result = NEDA_FAILURE;
+  }
+  _mapping->file = -1;
+  return result;
+}
+#endif
+
+#include <stdio.h>
+
+/* Version of snapshot format, which "save" writes. */
+#define NEDA_SNAPSHOT_VERSION 1UL
+
+/* Header of snapshot file. It is followed by data of array, which is
+ * written as is, so snapshot can be loaded only on the same platform
+ * with the same element type. Fields are "unsigned long", so their
+ * size depends on platform, but "reserved" pads header to 64 bytes on
+ * every platform, so mapped data is aligned.
+ */
+typedef struct neda_snapshot_header
+{
+  char magic[8];
+  unsigned long version;
+  unsigned long element_size;
+  unsigned long count;
+  unsigned long checksum;
+  unsigned char reserved[64 - 8 - 4 * sizeof(unsigned long)];
+} neda_snapshot_header;
+
+/* Compilation fails, if header is not 64 bytes. */
+typedef char neda_snapshot_header_size_check[
+    sizeof(struct neda_snapshot_header) == 64 ? 1 : -1];
+
+/* \returns checksum of "_size" bytes. Words are mixed in 4 separate
+ * lanes, so checksum of big snapshot is not limited by latency of
+ * multiplication. */
+NEDA_COMMON unsigned long neda_checksum(const void *_data, const size_t _size)
+{
+  const unsigned char *bytes = (const unsigned char *)_data;
+  unsigned long lanes[4] = {1UL, 2UL, 3UL, 4UL};
+  unsigned long word, result = (unsigned long)_size;
+  NEDA_REGISTER size_t i = 0;
+  NEDA_REGISTER size_t j;
+  while (i + sizeof(lanes) <= _size)
+  {
+    j = 0;
+    while (j < 4)
+    {
+      memcpy(&word, bytes + i + j * sizeof(word), sizeof(word));
+      lanes[j] = (lanes[j] ^ word) * 0x9E3779B1UL;
+      lanes[j] ^= lanes[j] >> 15;
+      j++;
+    }
+    i += sizeof(lanes);
+  }
+  j = 0;
+  while (j < 4)
+  {
+    result = (result ^ lanes[j]) * 0x9E3779B1UL;
+    j++;
+  }
+  while (i < _size)
+  {
+    result = (result ^ bytes[i]) * 0x9E3779B1UL;
+    i++;
+  }
+  return result ^ (result >> 15);
+}
+
+NEDA_COMMON void neda_snapshot__make_header(
+    struct neda_snapshot_header *_header,
+    const size_t _element_size,
+    const void *_data,
+    const size_t _count)
+{
+  memcpy(_header->magic, "NEDASNAP", sizeof(_header->magic));
+  _header->version = NEDA_SNAPSHOT_VERSION;
+  _header->element_size = (unsigned long)_element_size;
+  _header->count = (unsigned long)_count;
+  _header->checksum = neda_checksum(_data, _element_size * _count);
+  memset(_header->reserved, 0, sizeof(_header->reserved));
+}
+
+/* \returns NEDA_SUCCESS, if header is written by "save" with elements
+ * of "_element_size" bytes, and count fits into nedasize_t. */
+NEDA_COMMON int neda_snapshot__check_header(
+    const struct neda_snapshot_header *_header,
+    const size_t _element_size)
+{
+  if (memcmp(_header->magic, "NEDASNAP", sizeof(_header->magic)) != 0 ||
+      _header->version != NEDA_SNAPSHOT_VERSION ||
+      _header->element_size != (unsigned long)_element_size ||
+      (unsigned long)(nedasize_t)_header->count != _header->count)
+  {
+    return NEDA_FAILURE;
+  }
+  return NEDA_SUCCESS;
+}
+
+/* Writes size of "_file" in bytes to "*_size". With NEDA_MMAP it is
+ * taken by "fstat", so files bigger than LONG_MAX are supported.
+ * \returns NEDA_FAILURE, if size is unknown. */
+NEDA_COMMON int neda_snapshot__file_size(FILE *_file, size_t *_size)
+{
+#ifdef NEDA_MMAP
+  struct stat status;
+  if (fstat(fileno(_file), &status) != 0)
+  {
+    return NEDA_FAILURE;
+  }
+  *_size = (size_t)status.st_size;
+#else
+  const long position = ftell(_file);
+  long end;
+  if (position < 0 || fseek(_file, 0, SEEK_END) != 0)
+  {
+    return NEDA_FAILURE;
+  }
+  end = ftell(_file);
+  if (end < 0 || fseek(_file, position, SEEK_SET) != 0)
+  {
+    return NEDA_FAILURE;
+  }
+  *_size = (size_t)end;
+#endif
+  return NEDA_SUCCESS;
+}
+
+#ifdef NEDA_MMAP
+/* Snapshot, which is mapped read-only by "open_mapped". */
+typedef struct neda_snapshot
+{
+  void *address;
+  size_t size;
+} neda_snapshot;
+
+/* Maps snapshot file at "_path" and checks it's header. Checksum is
+ * checked only if "_verify" is logical true, because it reads every
+ * page of file. */
+NEDA_COMMON int neda_snapshot__open(
+    struct neda_snapshot *_snapshot,
+    const char *_path,
+    const size_t _element_size,
+    const int _verify)
+{
+  const struct neda_snapshot_header *header;
+  struct stat status;
+  int file;
+  NEDA_ASSERT(_snapshot && _path);
+  _snapshot->address = 0;
+  _snapshot->size = 0;
+  file = open(_path, O_RDONLY);
+  if (file < 0)
+  {
+    return NEDA_FAILURE;
+  }
+  if (fstat(file, &status) != 0 ||
+      (size_t)status.st_size < sizeof(struct neda_snapshot_header))
+  {
+    close(file);
+    return NEDA_FAILURE;
+  }
+  _snapshot->address = mmap(
+      0,
+      (size_t)status.st_size,
+      PROT_READ,
+      MAP_SHARED,
+      file,
+      0);
+  /* Mapping keeps file open. */
+  close(file);
+  if (_snapshot->address == MAP_FAILED)
+  {
+    _snapshot->address = 0;
+    return NEDA_FAILURE;
+  }
+  _snapshot->size = (size_t)status.st_size;
+  header = (const struct neda_snapshot_header *)_snapshot->address;
+  if (neda_snapshot__check_header(header, _element_size) != NEDA_SUCCESS ||
+      header->count > (_snapshot->size - sizeof(*header)) / _element_size ||
+      (_verify &&
+       neda_checksum(header + 1, header->count * _element_size) !=
+           header->checksum))
+  {
+    munmap(_snapshot->address, _snapshot->size);
+    _snapshot->address = 0;
+    _snapshot->size = 0;
+    return NEDA_FAILURE;
+  }
+  return NEDA_SUCCESS;
+}
+
+NEDA_COMMON void neda_snapshot__close(struct neda_snapshot *_snapshot)
+{
+  NEDA_ASSERT(_snapshot);
+  if (_snapshot->address)
+  {
+    munmap(_snapshot->address, _snapshot->size);
+  }
+  _snapshot->address = 0;
+  _snapshot->size = 0;
+}
+#endif
+
+/* Ranges smaller than this are sorted by insertion sort. */
+#ifndef NEDA_SORT_INSERTION_THRESHOLD
+#define NEDA_SORT_INSERTION_THRESHOLD 24
+#endif
+
+/* Ranges bigger than this use pseudomedian of 9 as pivot. */
+#ifndef NEDA_SORT_NINTHER_THRESHOLD
+#define NEDA_SORT_NINTHER_THRESHOLD 128
 #endif
 
-#define NEDA_CHUNK_RESERVE(_chunk_size, _buffer_size) (((nedasize_t)((float)(_buffer_size) / (float)(_chunk_size)) + 1) * _chunk_size)
+/* Moves, after which partial insertion sort gives up. */
+#ifndef NEDA_SORT_PARTIAL_LIMIT
+#define NEDA_SORT_PARTIAL_LIMIT 8
+#endif
+
+/* Growth policies of "reserve" function:
+ *   NEDA_GROWTH_CHUNK - capacity grows by "_chunk_size" steps (default);
+ *   NEDA_GROWTH_GEOMETRIC_1_5 - capacity grows at least by 1.5 times;
+ *   NEDA_GROWTH_GEOMETRIC_2 - capacity grows at least by 2 times;
+ *   NEDA_GROWTH_CALLBACK - capacity is calculated by function, which was
+ *                          set by "set_growth_function".
+ * Geometric policies gives amortized O(1) "push_back", chunk policy
+ * gives O(n) "push_back" on big arrays, but wastes less memory.
+ */
+#define NEDA_GROWTH_CHUNK 0
+#define NEDA_GROWTH_GEOMETRIC_1_5 1
+#define NEDA_GROWTH_GEOMETRIC_2 2
+#define NEDA_GROWTH_CALLBACK 3
+
+/* Smallest multiple of "_chunk_size", which is bigger than "_buffer_size".
+ * Integer math is used, so it is exact for any nedasize_t. */
+#define NEDA_CHUNK_RESERVE(_chunk_size, _buffer_size) (((nedasize_t)(_buffer_size) / (nedasize_t)(_chunk_size) + 1) * (nedasize_t)(_chunk_size))
 /* \returns logical false, if array is valid. */
 #define NEDA_VALIDATE(_da_ptr) (!_da_ptr || (_da_ptr->size > _da_ptr->capacity || ((_da_ptr->size > 1) && !_da_ptr->data)))
 
+/* Sorting engine, which is used by "sort" and "quick_sort". It is
+ * pattern-defeating quicksort (pdqsort by Orson Peters): median of 3
+ * (or ninther on big ranges) pivots, insertion sort on small ranges
+ * and heap sort, if too many bad partitions happened.
+ * "_less(_context, _a, _b)" should return logical true, if "_a" should
+ * be placed before "_b". Elements are moved by
+ * "_move(_context, _destination, _source)" and swapped by
+ * "_swap(_context, _a, _b)". "_context" is passed to every call as is.
+ */
+#define NEDA_SORT_ENGINE_MOVE(_name, _type, _context_type, _less, _move, _swap) \
+  NEDA_INTERNAL void _name##_sort2(                                             \
+      _type *_a,                                                                \
+      _type *_b,                                                                \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    if (_less(_context, _b, _a))                                                \
+    {                                                                           \
+      _swap(_context, _a, _b);                                                  \
+    }                                                                           \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_sort3(                                             \
+      _type *_a,                                                                \
+      _type *_b,                                                                \
+      _type *_c,                                                                \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    _name##_sort2(_a, _b, _context);                                            \
+    _name##_sort2(_b, _c, _context);                                            \
+    _name##_sort2(_a, _b, _context);                                            \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_insertion_sort(                                    \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER _type *current;                                               \
+    NEDA_REGISTER _type *sift;                                                  \
+    _type temp;                                                                 \
+    if (_first == _last)                                                        \
+    {                                                                           \
+      return;                                                                   \
+    }                                                                           \
+    current = _first + 1;                                                       \
+    while (current < _last)                                                     \
+    {                                                                           \
+      if (_less(_context, current, current - 1))                                \
+      {                                                                         \
+        _move(_context, &temp, current);                                        \
+        sift = current;                                                         \
+        do                                                                      \
+        {                                                                       \
+          _move(_context, sift, sift - 1);                                      \
+          sift--;                                                               \
+        } while (sift != _first && _less(_context, &temp, sift - 1));           \
+        _move(_context, sift, &temp);                                           \
+      }                                                                         \
+      current++;                                                                \
+    }                                                                           \
+  }                                                                             \
+  /* Element before "_first" should not be greater than any element             \
+     of range, so inner loop does not need bounds check. */                     \
+  NEDA_INTERNAL void _name##_unguarded_insertion_sort(                          \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER _type *current;                                               \
+    NEDA_REGISTER _type *sift;                                                  \
+    _type temp;                                                                 \
+    if (_first == _last)                                                        \
+    {                                                                           \
+      return;                                                                   \
+    }                                                                           \
+    current = _first + 1;                                                       \
+    while (current < _last)                                                     \
+    {                                                                           \
+      if (_less(_context, current, current - 1))                                \
+      {                                                                         \
+        _move(_context, &temp, current);                                        \
+        sift = current;                                                         \
+        do                                                                      \
+        {                                                                       \
+          _move(_context, sift, sift - 1);                                      \
+          sift--;                                                               \
+        } while (_less(_context, &temp, sift - 1));                             \
+        _move(_context, sift, &temp);                                           \
+      }                                                                         \
+      current++;                                                                \
+    }                                                                           \
+  }                                                                             \
+  /* Insertion sort, which gives up after NEDA_SORT_PARTIAL_LIMIT               \
+     moves. \returns logical true, if range was sorted. */                      \
+  NEDA_INTERNAL int _name##_partial_insertion_sort(                             \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER _type *current;                                               \
+    NEDA_REGISTER _type *sift;                                                  \
+    NEDA_REGISTER nedasize_t moves = 0;                                         \
+    _type temp;                                                                 \
+    if (_first == _last)                                                        \
+    {                                                                           \
+      return 1;                                                                 \
+    }                                                                           \
+    current = _first + 1;                                                       \
+    while (current < _last)                                                     \
+    {                                                                           \
+      if (moves > NEDA_SORT_PARTIAL_LIMIT)                                      \
+      {                                                                         \
+        return 0;                                                               \
+      }                                                                         \
+      if (_less(_context, current, current - 1))                                \
+      {                                                                         \
+        _move(_context, &temp, current);                                        \
+        sift = current;                                                         \
+        do                                                                      \
+        {                                                                       \
+          _move(_context, sift, sift - 1);                                      \
+          sift--;                                                               \
+        } while (sift != _first && _less(_context, &temp, sift - 1));           \
+        _move(_context, sift, &temp);                                           \
+        moves += (nedasize_t)(current - sift);                                  \
+      }                                                                         \
+      current++;                                                                \
+    }                                                                           \
+    return 1;                                                                   \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_sift_down(                                         \
+      _type *_first,                                                            \
+      nedasize_t _root,                                                         \
+      const nedasize_t _size,                                                   \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER nedasize_t child;                                             \
+    _type temp;                                                                 \
+    _move(_context, &temp, &_first[_root]);                                     \
+    while ((child = _root * 2 + 1) < _size)                                     \
+    {                                                                           \
+      if (child + 1 < _size &&                                                  \
+          _less(_context, &_first[child], &_first[child + 1]))                  \
+      {                                                                         \
+        child++;                                                                \
+      }                                                                         \
+      if (!_less(_context, &temp, &_first[child]))                              \
+      {                                                                         \
+        break;                                                                  \
+      }                                                                         \
+      _move(_context, &_first[_root], &_first[child]);                          \
+      _root = child;                                                            \
+    }                                                                           \
+    _move(_context, &_first[_root], &temp);                                     \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_heap_sort(                                         \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER nedasize_t size = (nedasize_t)(_last - _first);               \
+    NEDA_REGISTER nedasize_t i = size / 2;                                      \
+    while (i > 0)                                                               \
+    {                                                                           \
+      i--;                                                                      \
+      _name##_sift_down(_first, i, size, _context);                             \
+    }                                                                           \
+    while (size > 1)                                                            \
+    {                                                                           \
+      size--;                                                                   \
+      _swap(_context, _first, _first + size);                                   \
+      _name##_sift_down(_first, 0, size, _context);                             \
+    }                                                                           \
+  }                                                                             \
+  /* Elements equal to pivot go to the right part. */                           \
+  NEDA_INTERNAL _type *_name##_partition_right(                                 \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      int *_already_partitioned,                                                \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER _type *left = _first;                                         \
+    NEDA_REGISTER _type *right = _last;                                         \
+    _type *pivot_position;                                                      \
+    _type pivot;                                                                \
+    _move(_context, &pivot, _first);                                            \
+    do                                                                          \
+    {                                                                           \
+      left++;                                                                   \
+    } while (_less(_context, left, &pivot));                                    \
+    if (left - 1 == _first)                                                     \
+    {                                                                           \
+      while (left < right)                                                      \
+      {                                                                         \
+        right--;                                                                \
+        if (_less(_context, right, &pivot))                                     \
+        {                                                                       \
+          break;                                                                \
+        }                                                                       \
+      }                                                                         \
+    }                                                                           \
+    else                                                                        \
+    {                                                                           \
+      do                                                                        \
+      {                                                                         \
+        right--;                                                                \
+      } while (!_less(_context, right, &pivot));                                \
+    }                                                                           \
+    *_already_partitioned = left >= right;                                      \
+    while (left < right)                                                        \
+    {                                                                           \
+      _swap(_context, left, right);                                             \
+      do                                                                        \
+      {                                                                         \
+        left++;                                                                 \
+      } while (_less(_context, left, &pivot));                                  \
+      do                                                                        \
+      {                                                                         \
+        right--;                                                                \
+      } while (!_less(_context, right, &pivot));                                \
+    }                                                                           \
+    pivot_position = left - 1;                                                  \
+    _move(_context, _first, pivot_position);                                    \
+    _move(_context, pivot_position, &pivot);                                    \
+    return pivot_position;                                                      \
+  }                                                                             \
+  /* Elements equal to pivot go to the left part. Used when pivot is            \
+     equal to element before range, so all equal elements are put in            \
+     place at once. */                                                          \
+  NEDA_INTERNAL _type *_name##_partition_left(                                  \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER _type *left = _first;                                         \
+    NEDA_REGISTER _type *right = _last;                                         \
+    _type pivot;                                                                \
+    _move(_context, &pivot, _first);                                            \
+    do                                                                          \
+    {                                                                           \
+      right--;                                                                  \
+    } while (_less(_context, &pivot, right));                                   \
+    if (right + 1 == _last)                                                     \
+    {                                                                           \
+      while (left < right)                                                      \
+      {                                                                         \
+        left++;                                                                 \
+        if (_less(_context, &pivot, left))                                      \
+        {                                                                       \
+          break;                                                                \
+        }                                                                       \
+      }                                                                         \
+    }                                                                           \
+    else                                                                        \
+    {                                                                           \
+      do                                                                        \
+      {                                                                         \
+        left++;                                                                 \
+      } while (!_less(_context, &pivot, left));                                 \
+    }                                                                           \
+    while (left < right)                                                        \
+    {                                                                           \
+      _swap(_context, left, right);                                             \
+      do                                                                        \
+      {                                                                         \
+        right--;                                                                \
+      } while (_less(_context, &pivot, right));                                 \
+      do                                                                        \
+      {                                                                         \
+        left++;                                                                 \
+      } while (!_less(_context, &pivot, left));                                 \
+    }                                                                           \
+    _move(_context, _first, right);                                             \
+    _move(_context, right, &pivot);                                             \
+    return right;                                                               \
+  }                                                                             \
+  /* Swaps some elements of unbalanced partition to break patterns. */          \
+  NEDA_INTERNAL void _name##_break_patterns(                                    \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER nedasize_t size = (nedasize_t)(_last - _first);               \
+    if (size < NEDA_SORT_INSERTION_THRESHOLD)                                   \
+    {                                                                           \
+      return;                                                                   \
+    }                                                                           \
+    _swap(_context, _first, _first + size / 4);                                 \
+    _swap(_context, _last - 1, _last - size / 4);                               \
+    if (size > NEDA_SORT_NINTHER_THRESHOLD)                                     \
+    {                                                                           \
+      _swap(_context, _first + 1, _first + (size / 4 + 1));                     \
+      _swap(_context, _first + 2, _first + (size / 4 + 2));                     \
+      _swap(_context, _last - 2, _last - (size / 4 + 1));                       \
+      _swap(_context, _last - 3, _last - (size / 4 + 2));                       \
+    }                                                                           \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_loop(                                              \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      int _bad_allowed,                                                         \
+      int _leftmost,                                                            \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER nedasize_t size;                                              \
+    NEDA_REGISTER nedasize_t half;                                              \
+    nedasize_t left_size, right_size;                                           \
+    _type *pivot_position;                                                      \
+    int already_partitioned;                                                    \
+    while (1)                                                                   \
+    {                                                                           \
+      size = (nedasize_t)(_last - _first);                                      \
+      if (size < NEDA_SORT_INSERTION_THRESHOLD)                                 \
+      {                                                                         \
+        if (_leftmost)                                                          \
+        {                                                                       \
+          _name##_insertion_sort(_first, _last, _context);                      \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+          _name##_unguarded_insertion_sort(_first, _last, _context);            \
+        }                                                                       \
+        return;                                                                 \
+      }                                                                         \
+      half = size / 2;                                                          \
+      if (size > NEDA_SORT_NINTHER_THRESHOLD)                                   \
+      {                                                                         \
+        _name##_sort3(                                                          \
+            _first, _first + half, _last - 1, _context);                        \
+        _name##_sort3(                                                          \
+            _first + 1, _first + (half - 1), _last - 2, _context);              \
+        _name##_sort3(                                                          \
+            _first + 2, _first + (half + 1), _last - 3, _context);              \
+        _name##_sort3(                                                          \
+            _first + (half - 1), _first + half, _first + (half + 1), _context); \
+        _swap(_context, _first, _first + half);                                 \
+      }                                                                         \
+      else                                                                      \
+      {                                                                         \
+        _name##_sort3(_first + half, _first, _last - 1, _context);              \
+      }                                                                         \
+      if (!_leftmost && !_less(_context, _first - 1, _first))                   \
+      {                                                                         \
+        _first = _name##_partition_left(_first, _last, _context) + 1;           \
+        continue;                                                               \
+      }                                                                         \
+      pivot_position = _name##_partition_right(                                 \
+          _first,                                                               \
+          _last,                                                                \
+          &already_partitioned,                                                 \
+          _context);                                                            \
+      left_size = (nedasize_t)(pivot_position - _first);                        \
+      right_size = (nedasize_t)(_last - (pivot_position + 1));                  \
+      if (left_size < size / 8 || right_size < size / 8)                        \
+      {                                                                         \
+        if (--_bad_allowed == 0)                                                \
+        {                                                                       \
+          _name##_heap_sort(_first, _last, _context);                           \
+          return;                                                               \
+        }                                                                       \
+        _name##_break_patterns(_first, pivot_position, _context);               \
+        _name##_break_patterns(pivot_position + 1, _last, _context);            \
+      }                                                                         \
+      else if (already_partitioned &&                                           \
+               _name##_partial_insertion_sort(                                  \
+                   _first, pivot_position, _context) &&                         \
+               _name##_partial_insertion_sort(                                  \
+                   pivot_position + 1, _last, _context))                        \
+      {                                                                         \
+        return;                                                                 \
+      }                                                                         \
+      /* Recursion goes into smaller part, so stack depth is O(log n). */       \
+      if (left_size < right_size)                                               \
+      {                                                                         \
+        _name##_loop(                                                           \
+            _first, pivot_position, _bad_allowed, _leftmost, _context);         \
+        _first = pivot_position + 1;                                            \
+        _leftmost = 0;                                                          \
+      }                                                                         \
+      else                                                                      \
+      {                                                                         \
+        _name##_loop(pivot_position + 1, _last, _bad_allowed, 0, _context);     \
+        _last = pivot_position;                                                 \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+  /* Introselect: range is partitioned like in "_loop", but only the            \
+     part with "_nth" is processed further. When it is done, "_nth"             \
+     is the same as in sorted range, elements before it are not                 \
+     greater and elements after it are not less. If too many bad                \
+     partitions happened, the rest is sorted by heap sort. */                   \
+  NEDA_INTERNAL void _name##_select(                                            \
+      _type *_first,                                                            \
+      _type *_nth,                                                              \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    _type *const begin = _first;                                                \
+    NEDA_REGISTER nedasize_t size = (nedasize_t)(_last - _first);               \
+    NEDA_REGISTER nedasize_t half;                                              \
+    int bad_allowed = 1;                                                        \
+    _type *pivot_position;                                                      \
+    int already_partitioned;                                                    \
+    while (size >>= 1)                                                          \
+    {                                                                           \
+      bad_allowed++;                                                            \
+    }                                                                           \
+    while ((size = (nedasize_t)(_last - _first)) >=                             \
+           NEDA_SORT_INSERTION_THRESHOLD)                                       \
+    {                                                                           \
+      half = size / 2;                                                          \
+      if (size > NEDA_SORT_NINTHER_THRESHOLD)                                   \
+      {                                                                         \
+        _name##_sort3(                                                          \
+            _first, _first + half, _last - 1, _context);                        \
+        _name##_sort3(                                                          \
+            _first + 1, _first + (half - 1), _last - 2, _context);              \
+        _name##_sort3(                                                          \
+            _first + 2, _first + (half + 1), _last - 3, _context);              \
+        _name##_sort3(                                                          \
+            _first + (half - 1), _first + half, _first + (half + 1), _context); \
+        _swap(_context, _first, _first + half);                                 \
+      }                                                                         \
+      else                                                                      \
+      {                                                                         \
+        _name##_sort3(_first + half, _first, _last - 1, _context);              \
+      }                                                                         \
+      /* Pivot is equal to element before range, so elements equal              \
+         to it are already in place. */                                         \
+      if (_first != begin && !_less(_context, _first - 1, _first))              \
+      {                                                                         \
+        pivot_position = _name##_partition_left(_first, _last, _context);       \
+        if (_nth <= pivot_position)                                             \
+        {                                                                       \
+          return;                                                               \
+        }                                                                       \
+        _first = pivot_position + 1;                                            \
+        continue;                                                               \
+      }                                                                         \
+      pivot_position = _name##_partition_right(                                 \
+          _first,                                                               \
+          _last,                                                                \
+          &already_partitioned,                                                 \
+          _context);                                                            \
+      if (pivot_position == _nth)                                               \
+      {                                                                         \
+        return;                                                                 \
+      }                                                                         \
+      if ((nedasize_t)(pivot_position - _first) < size / 8 ||                   \
+          (nedasize_t)(_last - (pivot_position + 1)) < size / 8)                \
+      {                                                                         \
+        if (--bad_allowed == 0)                                                 \
+        {                                                                       \
+          _name##_heap_sort(_first, _last, _context);                           \
+          return;                                                               \
+        }                                                                       \
+        _name##_break_patterns(_first, pivot_position, _context);               \
+        _name##_break_patterns(pivot_position + 1, _last, _context);            \
+      }                                                                         \
+      if (_nth < pivot_position)                                                \
+      {                                                                         \
+        _last = pivot_position;                                                 \
+      }                                                                         \
+      else                                                                      \
+      {                                                                         \
+        _first = pivot_position + 1;                                            \
+      }                                                                         \
+    }                                                                           \
+    _name##_insertion_sort(_first, _last, _context);                            \
+  }                                                                             \
+  NEDA_INTERNAL void _name##_range(                                             \
+      _type *_first,                                                            \
+      _type *_last,                                                             \
+      const _context_type *_context)                                            \
+  {                                                                             \
+    NEDA_REGISTER nedasize_t size = (nedasize_t)(_last - _first);               \
+    NEDA_REGISTER int bad_allowed = 1;                                          \
+    while (size >>= 1)                                                          \
+    {                                                                           \
+      bad_allowed++;                                                            \
+    }                                                                           \
+    _name##_loop(_first, _last, bad_allowed, 1, _context);                      \
+  }
+
+/* Sorting engine, which moves elements by assignment. */
+#define NEDA_SORT_ENGINE(_name, _type, _context_type, _less) \
+  NEDA_INTERNAL void _name##_assign_move(                    \
+      const _context_type *_context,                         \
+      _type *_destination,                                   \
+      _type *_source)                                        \
+  {                                                          \
+    NEDA_UNUSED(_context);                                   \
+    *_destination = *_source;                                \
+  }                                                          \
+  NEDA_INTERNAL void _name##_assign_swap(                    \
+      const _context_type *_context,                         \
+      _type *_a,                                             \
+      _type *_b)                                             \
+  {                                                          \
+    const _type temp = *_a;                                  \
+    NEDA_UNUSED(_context);                                   \
+    *_a = *_b;                                               \
+    *_b = temp;                                              \
+  }                                                          \
+  NEDA_SORT_ENGINE_MOVE(                                     \
+      _name,                                                 \
+      _type,                                                 \
+      _context_type,                                         \
+      _less,                                                 \
+      _name##_assign_move,                                   \
+      _name##_assign_swap)
+
+/* Runs shorter than this are extended by binary insertion sort in
+ * "stable_sort", ranges shorter than this are not merged at all. */
+#ifndef NEDA_STABLE_SORT_MIN_MERGE
+#define NEDA_STABLE_SORT_MIN_MERGE 64
+#endif
+
+/* Count of elements, which should be taken from one run in a row,
+ * before merge switches to galloping. */
+#ifndef NEDA_STABLE_SORT_MIN_GALLOP
+#define NEDA_STABLE_SORT_MIN_GALLOP 7
+#endif
+
+/* Size of runs stack of "stable_sort", it is enough for 2^64
+ * elements. */
+#define NEDA_STABLE_SORT_MAX_RUNS 96
+
+/* Stable sorting engine, which is used by "stable_sort". It is
+ * adaptive merge sort (timsort by Tim Peters): natural runs are found
+ * and extended by binary insertion sort, runs are merged from stack
+ * with balanced sizes, merge switches to galloping, when one run
+ * wins many times in a row. Sorted, reversed and partially sorted
+ * ranges are sorted in linear or nearly linear time. "_less" and
+ * "_context" have the same meaning as in NEDA_SORT_ENGINE.
+ */
+#define NEDA_STABLE_SORT_ENGINE(_name, _type, _context_type, _less)         \
+  struct _name##_state                                                      \
+  {                                                                         \
+    _type *scratch;                                                         \
+    nedasize_t min_gallop;                                                  \
+    nedasize_t runs_count;                                                  \
+    nedasize_t bases[NEDA_STABLE_SORT_MAX_RUNS];                            \
+    nedasize_t sizes[NEDA_STABLE_SORT_MAX_RUNS];                            \
+    const _context_type *context;                                           \
+  };                                                                        \
+  /* \returns size of run, which starts at "_first". Strictly               \
+     descending run is reversed, so every run is ascending. */              \
+  NEDA_INTERNAL nedasize_t _name##_count_run(                               \
+      _type *_first,                                                        \
+      _type *_last,                                                         \
+      const _context_type *_context)                                        \
+  {                                                                         \
+    _type *current = _first + 1;                                            \
+    _type *left, *right;                                                    \
+    _type temp;                                                             \
+    if (current >= _last)                                                   \
+    {                                                                       \
+      return (nedasize_t)(_last - _first);                                  \
+    }                                                                       \
+    if (_less(_context, current, _first))                                   \
+    {                                                                       \
+      current++;                                                            \
+      while (current < _last && _less(_context, current, current - 1))      \
+      {                                                                     \
+        current++;                                                          \
+      }                                                                     \
+      left = _first;                                                        \
+      right = current - 1;                                                  \
+      while (left < right)                                                  \
+      {                                                                     \
+        temp = *left;                                                       \
+        *left = *right;                                                     \
+        *right = temp;                                                      \
+        left++;                                                             \
+        right--;                                                            \
+      }                                                                     \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+      current++;                                                            \
+      while (current < _last && !_less(_context, current, current - 1))     \
+      {                                                                     \
+        current++;                                                          \
+      }                                                                     \
+    }                                                                       \
+    return (nedasize_t)(current - _first);                                  \
+  }                                                                         \
+  /* Sorts [_first; _last), where [_first; _sorted) is already              \
+     sorted. Place of every element is found by binary search after         \
+     equal elements, so sort is stable. */                                  \
+  NEDA_INTERNAL void _name##_binary_insertion_sort(                         \
+      _type *_first,                                                        \
+      _type *_last,                                                         \
+      _type *_sorted,                                                       \
+      const _context_type *_context)                                        \
+  {                                                                         \
+    _type *low, *high, *middle;                                             \
+    _type pivot;                                                            \
+    while (_sorted < _last)                                                 \
+    {                                                                       \
+      pivot = *_sorted;                                                     \
+      low = _first;                                                         \
+      high = _sorted;                                                       \
+      while (low < high)                                                    \
+      {                                                                     \
+        middle = low + (high - low) / 2;                                    \
+        if (_less(_context, &pivot, middle))                                \
+        {                                                                   \
+          high = middle;                                                    \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+          low = middle + 1;                                                 \
+        }                                                                   \
+      }                                                                     \
+      memmove(low + 1, low, sizeof(_type) * (size_t)(_sorted - low));       \
+      *low = pivot;                                                         \
+      _sorted++;                                                            \
+    }                                                                       \
+  }                                                                         \
+  /* \returns count of first elements of sorted "_base", which are          \
+     less than "_key". Search starts at "_hint" and checks elements         \
+     at growing distance, so it is fast, if answer is near "_hint". */      \
+  NEDA_INTERNAL nedasize_t _name##_gallop_left(                             \
+      const _type *_key,                                                    \
+      const _type *_base,                                                   \
+      const nedasize_t _size,                                               \
+      const nedasize_t _hint,                                               \
+      const _context_type *_context)                                        \
+  {                                                                         \
+    NEDA_REGISTER nedasize_t last_offset = 0;                               \
+    NEDA_REGISTER nedasize_t offset = 1;                                    \
+    nedasize_t max_offset, low, high, middle;                               \
+    if (_less(_context, &_base[_hint], _key))                               \
+    {                                                                       \
+      max_offset = _size - _hint;                                           \
+      while (offset < max_offset &&                                         \
+             _less(_context, &_base[_hint + offset], _key))                 \
+      {                                                                     \
+        last_offset = offset;                                               \
+        offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;     \
+      }                                                                     \
+      offset = offset < max_offset ? offset : max_offset;                   \
+      low = _hint + last_offset + 1;                                        \
+      high = _hint + offset;                                                \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+      max_offset = _hint + 1;                                               \
+      while (offset < max_offset &&                                         \
+             !_less(_context, &_base[_hint - offset], _key))                \
+      {                                                                     \
+        last_offset = offset;                                               \
+        offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;     \
+      }                                                                     \
+      offset = offset < max_offset ? offset : max_offset;                   \
+      low = _hint + 1 - offset;                                             \
+      high = _hint - last_offset;                                           \
+    }                                                                       \
+    while (low < high)                                                      \
+    {                                                                       \
+      middle = low + (high - low) / 2;                                      \
+      if (_less(_context, &_base[middle], _key))                            \
+      {                                                                     \
+        low = middle + 1;                                                   \
+      }                                                                     \
+      else                                                                  \
+      {                                                                     \
+        high = middle;                                                      \
+      }                                                                     \
+    }                                                                       \
+    return low;                                                             \
+  }                                                                         \
+  /* \returns count of first elements of sorted "_base", which are          \
+     not greater than "_key". */                                            \
+  NEDA_INTERNAL nedasize_t _name##_gallop_right(                            \
+      const _type *_key,                                                    \
+      const _type *_base,                                                   \
+      const nedasize_t _size,                                               \
+      const nedasize_t _hint,                                               \
+      const _context_type *_context)                                        \
+  {                                                                         \
+    NEDA_REGISTER nedasize_t last_offset = 0;                               \
+    NEDA_REGISTER nedasize_t offset = 1;                                    \
+    nedasize_t max_offset, low, high, middle;                               \
+    if (_less(_context, _key, &_base[_hint]))                               \
+    {                                                                       \
+      max_offset = _hint + 1;                                               \
+      while (offset < max_offset &&                                         \
+             _less(_context, _key, &_base[_hint - offset]))                 \
+      {                                                                     \
+        last_offset = offset;                                               \
+        offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;     \
+      }                                                                     \
+      offset = offset < max_offset ? offset : max_offset;                   \
+      low = _hint + 1 - offset;                                             \
+      high = _hint - last_offset;                                           \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+      max_offset = _size - _hint;                                           \
+      while (offset < max_offset &&                                         \
+             !_less(_context, _key, &_base[_hint + offset]))                \
+      {                                                                     \
+        last_offset = offset;                                               \
+        offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;     \
+      }                                                                     \
+      offset = offset < max_offset ? offset : max_offset;                   \
+      low = _hint + last_offset + 1;                                        \
+      high = _hint + offset;                                                \
+    }                                                                       \
+    while (low < high)                                                      \
+    {                                                                       \
+      middle = low + (high - low) / 2;                                      \
+      if (_less(_context, _key, &_base[middle]))                            \
+      {                                                                     \
+        high = middle;                                                      \
+      }                                                                     \
+      else                                                                  \
+      {                                                                     \
+        low = middle + 1;                                                   \
+      }                                                                     \
+    }                                                                       \
+    return low;                                                             \
+  }                                                                         \
+  /* Galloping continues, while it moves long blocks, otherwise it          \
+     gets harder to start again. */                                         \
+  NEDA_INTERNAL void _name##_gallop_result(                                 \
+      struct _name##_state *_state,                                         \
+      const nedasize_t _count_a,                                            \
+      const nedasize_t _count_b,                                            \
+      nedasize_t *_run_a,                                                   \
+      nedasize_t *_run_b)                                                   \
+  {                                                                         \
+    if (_count_a >= NEDA_STABLE_SORT_MIN_GALLOP ||                          \
+        _count_b >= NEDA_STABLE_SORT_MIN_GALLOP)                            \
+    {                                                                       \
+      if (_state->min_gallop > 1)                                           \
+      {                                                                     \
+        _state->min_gallop--;                                               \
+      }                                                                     \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+      _state->min_gallop++;                                                 \
+      *_run_a = 0;                                                          \
+      *_run_b = 0;                                                          \
+    }                                                                       \
+  }                                                                         \
+  /* Merges runs "_a" and "_b", which are neighbours, when "_a" is          \
+     not longer. "_a" is moved to scratch and merged from the left. */      \
+  NEDA_INTERNAL void _name##_merge_low(                                     \
+      struct _name##_state *_state,                                         \
+      _type *_a,                                                            \
+      nedasize_t _size_a,                                                   \
+      nedasize_t _size_b)                                                   \
+  {                                                                         \
+    const _type *scratch = _state->scratch;                                 \
+    const _type *b = _a + _size_a;                                          \
+    nedasize_t index_a = 0, index_b = 0, index = 0;                         \
+    nedasize_t run_a = 0, run_b = 0, count;                                 \
+    memcpy(_state->scratch, _a, sizeof(_type) * _size_a);                   \
+    while (index_a < _size_a && index_b < _size_b)                          \
+    {                                                                       \
+      if (run_a < _state->min_gallop && run_b < _state->min_gallop)         \
+      {                                                                     \
+        if (_less(_state->context, &b[index_b], &scratch[index_a]))         \
+        {                                                                   \
+          _a[index++] = b[index_b++];                                       \
+          run_b++;                                                          \
+          run_a = 0;                                                        \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+          _a[index++] = scratch[index_a++];                                 \
+          run_a++;                                                          \
+          run_b = 0;                                                        \
+        }                                                                   \
+        continue;                                                           \
+      }                                                                     \
+      count = _name##_gallop_right(                                         \
+          &b[index_b],                                                      \
+          scratch + index_a,                                                \
+          _size_a - index_a,                                                \
+          0,                                                                \
+          _state->context);                                                 \
+      memcpy(_a + index, scratch + index_a, sizeof(_type) * count);         \
+      index += count;                                                       \
+      index_a += count;                                                     \
+      run_a = count;                                                        \
+      count = 0;                                                            \
+      if (index_a < _size_a)                                                \
+      {                                                                     \
+        count = _name##_gallop_left(                                        \
+            &scratch[index_a],                                              \
+            b + index_b,                                                    \
+            _size_b - index_b,                                              \
+            0,                                                              \
+            _state->context);                                               \
+        memmove(_a + index, b + index_b, sizeof(_type) * count);            \
+        index += count;                                                     \
+        index_b += count;                                                   \
+      }                                                                     \
+      _name##_gallop_result(_state, run_a, count, &run_a, &run_b);          \
+    }                                                                       \
+    memcpy(                                                                 \
+        _a + index,                                                         \
+        scratch + index_a,                                                  \
+        sizeof(_type) * (_size_a - index_a));                               \
+  }                                                                         \
+  /* Same as "merge_low", but "_b" is shorter, so it is moved to            \
+     scratch and runs are merged from the right. */                         \
+  NEDA_INTERNAL void _name##_merge_high(                                    \
+      struct _name##_state *_state,                                         \
+      _type *_a,                                                            \
+      nedasize_t _size_a,                                                   \
+      nedasize_t _size_b)                                                   \
+  {                                                                         \
+    const _type *scratch = _state->scratch;                                 \
+    nedasize_t left_a = _size_a, left_b = _size_b;                          \
+    nedasize_t left = _size_a + _size_b;                                    \
+    nedasize_t run_a = 0, run_b = 0, count;                                 \
+    memcpy(_state->scratch, _a + _size_a, sizeof(_type) * _size_b);         \
+    while (left_a && left_b)                                                \
+    {                                                                       \
+      if (run_a < _state->min_gallop && run_b < _state->min_gallop)         \
+      {                                                                     \
+        if (_less(_state->context, &scratch[left_b - 1], &_a[left_a - 1]))  \
+        {                                                                   \
+          _a[--left] = _a[--left_a];                                        \
+          run_a++;                                                          \
+          run_b = 0;                                                        \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+          _a[--left] = scratch[--left_b];                                   \
+          run_b++;                                                          \
+          run_a = 0;                                                        \
+        }                                                                   \
+        continue;                                                           \
+      }                                                                     \
+      count = left_a - _name##_gallop_right(                                \
+                           &scratch[left_b - 1],                            \
+                           _a,                                              \
+                           left_a,                                          \
+                           left_a - 1,                                      \
+                           _state->context);                                \
+      left -= count;                                                        \
+      left_a -= count;                                                      \
+      memmove(_a + left, _a + left_a, sizeof(_type) * count);               \
+      run_a = count;                                                        \
+      count = 0;                                                            \
+      if (left_a)                                                           \
+      {                                                                     \
+        count = left_b - _name##_gallop_left(                               \
+                             &_a[left_a - 1],                               \
+                             scratch,                                       \
+                             left_b,                                        \
+                             left_b - 1,                                    \
+                             _state->context);                              \
+        left -= count;                                                      \
+        left_b -= count;                                                    \
+        memcpy(_a + left, scratch + left_b, sizeof(_type) * count);         \
+      }                                                                     \
+      _name##_gallop_result(_state, run_a, count, &run_a, &run_b);          \
+    }                                                                       \
+    memcpy(_a + left - left_b, scratch, sizeof(_type) * left_b);            \
+  }                                                                         \
+  /* Merges runs "_index" and "_index + 1" of stack. */                     \
+  NEDA_INTERNAL void _name##_merge_at(                                      \
+      struct _name##_state *_state,                                         \
+      _type *_data,                                                         \
+      const nedasize_t _index)                                              \
+  {                                                                         \
+    _type *a = _data + _state->bases[_index];                               \
+    nedasize_t size_a = _state->sizes[_index];                              \
+    nedasize_t size_b = _state->sizes[_index + 1];                          \
+    nedasize_t skip;                                                        \
+    _state->sizes[_index] = size_a + size_b;                                \
+    if (_index + 3 == _state->runs_count)                                   \
+    {                                                                       \
+      _state->bases[_index + 1] = _state->bases[_index + 2];                \
+      _state->sizes[_index + 1] = _state->sizes[_index + 2];                \
+    }                                                                       \
+    _state->runs_count--;                                                   \
+    /* Elements of "a", which are not greater than first element of         \
+       "b", and elements of "b", which are not less than last               \
+       element of "a", are already in place. */                             \
+    skip = _name##_gallop_right(a + size_a, a, size_a, 0, _state->context); \
+    a += skip;                                                              \
+    size_a -= skip;                                                         \
+    if (!size_a)                                                            \
+    {                                                                       \
+      return;                                                               \
+    }                                                                       \
+    size_b = _name##_gallop_left(                                           \
+        a + size_a - 1,                                                     \
+        a + size_a,                                                         \
+        size_b,                                                             \
+        size_b - 1,                                                         \
+        _state->context);                                                   \
+    if (!size_b)                                                            \
+    {                                                                       \
+      return;                                                               \
+    }                                                                       \
+    if (size_a <= size_b)                                                   \
+    {                                                                       \
+      _name##_merge_low(_state, a, size_a, size_b);                         \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+      _name##_merge_high(_state, a, size_a, size_b);                        \
+    }                                                                       \
+  }                                                                         \
+  /* Keeps sizes of runs on stack growing faster than Fibonacci             \
+     numbers from top to bottom, so stack stays small and merges            \
+     are balanced. */                                                       \
+  NEDA_INTERNAL void _name##_merge_collapse(                                \
+      struct _name##_state *_state,                                         \
+      _type *_data)                                                         \
+  {                                                                         \
+    nedasize_t *sizes = _state->sizes;                                      \
+    nedasize_t i;                                                           \
+    while (_state->runs_count > 1)                                          \
+    {                                                                       \
+      i = _state->runs_count - 2;                                           \
+      if ((i > 0 && sizes[i - 1] <= sizes[i] + sizes[i + 1]) ||             \
+          (i > 1 && sizes[i - 2] <= sizes[i - 1] + sizes[i]))               \
+      {                                                                     \
+        if (sizes[i - 1] < sizes[i + 1])                                    \
+        {                                                                   \
+          i--;                                                              \
+        }                                                                   \
+      }                                                                     \
+      else if (sizes[i] > sizes[i + 1])                                     \
+      {                                                                     \
+        break;                                                              \
+      }                                                                     \
+      _name##_merge_at(_state, _data, i);                                   \
+    }                                                                       \
+  }                                                                         \
+  /* Minimal size of run, so count of runs is power of two or a bit         \
+     less. */                                                               \
+  NEDA_INTERNAL nedasize_t _name##_min_run(nedasize_t _size)                \
+  {                                                                         \
+    nedasize_t remainder = 0;                                               \
+    while (_size >= NEDA_STABLE_SORT_MIN_MERGE)                             \
+    {                                                                       \
+      remainder |= _size & 1;                                               \
+      _size >>= 1;                                                          \
+    }                                                                       \
+    return _size + remainder;                                               \
+  }                                                                         \
+  /* Stable sort of [_first; _last). "_scratch" should have place           \
+     for half of range, it is not used, if range is smaller than            \
+     NEDA_STABLE_SORT_MIN_MERGE. */                                         \
+  NEDA_INTERNAL void _name##_range(                                         \
+      _type *_first,                                                        \
+      _type *_last,                                                         \
+      _type *_scratch,                                                      \
+      const _context_type *_context)                                        \
+  {                                                                         \
+    struct _name##_state state;                                             \
+    const nedasize_t size = (nedasize_t)(_last - _first);                   \
+    const nedasize_t min_run = _name##_min_run(size);                       \
+    nedasize_t base = 0, run, forced;                                       \
+    state.scratch = _scratch;                                               \
+    state.min_gallop = NEDA_STABLE_SORT_MIN_GALLOP;                         \
+    state.runs_count = 0;                                                   \
+    state.context = _context;                                               \
+    while (base < size)                                                     \
+    {                                                                       \
+      run = _name##_count_run(_first + base, _last, _context);              \
+      if (run < min_run)                                                    \
+      {                                                                     \
+        forced = size - base < min_run ? size - base : min_run;             \
+        _name##_binary_insertion_sort(                                      \
+            _first + base,                                                  \
+            _first + base + forced,                                         \
+            _first + base + run,                                            \
+            _context);                                                      \
+        run = forced;                                                       \
+      }                                                                     \
+      state.bases[state.runs_count] = base;                                 \
+      state.sizes[state.runs_count] = run;                                  \
+      state.runs_count++;                                                   \
+      _name##_merge_collapse(&state, _first);                               \
+      base += run;                                                          \
+    }                                                                       \
+    while (state.runs_count > 1)                                            \
+    {                                                                       \
+      run = state.runs_count - 2;                                           \
+      if (run > 0 && state.sizes[run - 1] < state.sizes[run + 1])           \
+      {                                                                     \
+        run--;                                                              \
+      }                                                                     \
+      _name##_merge_at(&state, _first, run);                                \
+    }                                                                       \
+  }
+
 #define NEDA_HEADER_POSTFIX(_postfix, _type)                                                                            \
   typedef int (*neda_##_postfix##__compare_function_type)(const _type *_a, const _type *_b);                            \
   typedef void (*neda_##_postfix##__swap_function_type)(_type * _a, _type * _b);                                        \
   typedef void (*neda_##_postfix##__move_function_type)(_type * _destination, _type * _source);                         \
+  typedef nedasize_t (*neda_##_postfix##__growth_function_type)(const nedasize_t _capacity, const nedasize_t _size);    \
+  typedef int (*neda_##_postfix##__predicate_function_type)(const _type *_element, void *_context);                     \
+  /* "swap" and "move" are called by sorting and "move" by shifting                                                     \
+     functions only, if they are not default ones. */                                                                   \
+  typedef struct neda_##_postfix##__functions                                                                           \
+  {                                                                                                                     \
+    neda_##_postfix##__compare_function_type compare;                                                                   \
+    neda_##_postfix##__swap_function_type swap;                                                                         \
+    neda_##_postfix##__move_function_type move;                                                                         \
+  } neda_##_postfix##__functions;                                                                                       \
   typedef struct neda_##_postfix                                                                                        \
   {                                                                                                                     \
     _type *data;                                                                                                        \
     nedasize_t capacity, size;                                                                                          \
+    const struct neda_##_postfix##__functions *functions;                                                               \
+    const struct neda_allocator *allocator;                                                                             \
   } neda_##_postfix;                                                                                                    \
   NEDA_DEF void neda_##_postfix##__memset(_type *_data, const _type _value, const nedasize_t _elem_count);              \
   NEDA_API void neda_##_postfix##__byte_memset(_type *_data, const unsigned char _value, const nedasize_t _elem_count); \
   NEDA_DEF void neda_##_postfix##__init(struct neda_##_postfix **_da);                                                  \
+  NEDA_DEF void neda_##_postfix##__init_allocator(                                                                      \
+      struct neda_##_postfix **_da, const struct neda_allocator *_allocator);                                           \
+  NEDA_DEF void neda_##_postfix##__init_in_place(struct neda_##_postfix *_da);                                          \
+  NEDA_DEF void neda_##_postfix##__init_in_place_allocator(                                                             \
+      struct neda_##_postfix *_da, const struct neda_allocator *_allocator);                                            \
+  NEDA_DEF void neda_##_postfix##__destroy(struct neda_##_postfix *_da);                                                \
   NEDA_DEF void neda_##_postfix##__reserve(struct neda_##_postfix *_da, const nedasize_t _size);                        \
   NEDA_DEF nedasize_t neda_##_postfix##__size(struct neda_##_postfix *_da);                                             \
   NEDA_DEF _type *neda_##_postfix##__data(struct neda_##_postfix *_da);                                                 \
@@ -189,6 +1978,16 @@ extern "C"
   NEDA_DEF void neda_##_postfix##__shrink_to_fit(struct neda_##_postfix *_da);                                          \
   NEDA_DEF void neda_##_postfix##__insert(struct neda_##_postfix *_da, const nedasize_t _index, const _type _value);    \
   NEDA_DEF void neda_##_postfix##__erase(struct neda_##_postfix *_da, const nedasize_t _index);                         \
+  NEDA_DEF void neda_##_postfix##__append_n(                                                                            \
+      struct neda_##_postfix *_da, const _type *_values, const nedasize_t _count);                                      \
+  NEDA_DEF void neda_##_postfix##__insert_range(                                                                        \
+      struct neda_##_postfix *_da, const nedasize_t _index, const _type *_values, const nedasize_t _count);             \
+  NEDA_DEF void neda_##_postfix##__erase_range(                                                                         \
+      struct neda_##_postfix *_da, const nedasize_t _first, const nedasize_t _last);                                    \
+  NEDA_DEF nedasize_t neda_##_postfix##__remove_if(                                                                     \
+      struct neda_##_postfix *_da, neda_##_postfix##__predicate_function_type _predicate, void *_context);              \
+  NEDA_DEF nedasize_t neda_##_postfix##__retain_indices(                                                                \
+      struct neda_##_postfix *_da, const nedasize_t *_indices, const nedasize_t _count);                                \
   NEDA_DEF void neda_##_postfix##__fill(struct neda_##_postfix *_da, const _type _value);                               \
   NEDA_DEF void neda_##_postfix##__fill_size(struct neda_##_postfix *_da, const nedasize_t _size, const _type _value);  \
   NEDA_DEF void neda_##_postfix##__copy(struct neda_##_postfix *_da1, struct neda_##_postfix *_da2);                    \
@@ -204,15 +2003,42 @@ extern "C"
   NEDA_DEF void neda_##_postfix##__set_default_move_function();                                                         \
   NEDA_DEF void neda_##_postfix##__set_move_function(                                                                   \
       neda_##_postfix##__move_function_type _move_function);                                                            \
+  NEDA_DEF void neda_##_postfix##__set_growth_function(                                                                 \
+      neda_##_postfix##__growth_function_type _growth_function);                                                        \
   NEDA_DEF void neda_##_postfix##__set_default_functions();                                                             \
+  NEDA_DEF const struct neda_##_postfix##__functions *neda_##_postfix##__default_functions();                           \
+  NEDA_DEF void neda_##_postfix##__set_functions(                                                                       \
+      struct neda_##_postfix *_da,                                                                                      \
+      const struct neda_##_postfix##__functions *_functions);                                                           \
   NEDA_DEF void neda_##_postfix##__sort(struct neda_##_postfix *_da);                                                   \
+  NEDA_DEF void neda_##_postfix##__quick_sort(struct neda_##_postfix *_da);                                             \
+  NEDA_DEF void neda_##_postfix##__stable_sort(struct neda_##_postfix *_da);                                            \
+  NEDA_DEF void neda_##_postfix##__nth_element(struct neda_##_postfix *_da, const nedasize_t _nth);                     \
+  NEDA_DEF void neda_##_postfix##__partial_sort(struct neda_##_postfix *_da, const nedasize_t _count);                  \
+  NEDA_DEF void neda_##_postfix##__top_k_push(struct neda_##_postfix *_top, const nedasize_t _k, const _type _value);   \
+  NEDA_DEF void neda_##_postfix##__top_k(                                                                               \
+      struct neda_##_postfix *_da, const nedasize_t _k, struct neda_##_postfix *_top);                                  \
+  NEDA_DEF nedasize_t neda_##_postfix##__lower_bound(struct neda_##_postfix *_da, const _type _value);                  \
+  NEDA_DEF nedasize_t neda_##_postfix##__upper_bound(struct neda_##_postfix *_da, const _type _value);                  \
+  NEDA_DEF void neda_##_postfix##__equal_range(                                                                         \
+      struct neda_##_postfix *_da, const _type _value, nedasize_t *_first, nedasize_t *_last);                          \
+  NEDA_DEF nedasize_t neda_##_postfix##__insert_sorted(struct neda_##_postfix *_da, const _type _value);                \
+  NEDA_DEF nedasize_t neda_##_postfix##__unique(struct neda_##_postfix *_da);                                           \
+  NEDA_DEF void neda_##_postfix##__eytzinger_build(struct neda_##_postfix *_da, struct neda_##_postfix *_layout);       \
+  NEDA_DEF nedasize_t neda_##_postfix##__eytzinger_lower_bound(struct neda_##_postfix *_layout, const _type _value);    \
   NEDA_DEF void neda_##_postfix##__clear(struct neda_##_postfix *_da);                                                  \
   NEDA_DEF void neda_##_postfix##__free(struct neda_##_postfix **_da);
 
-#define NEDA_BODY_IMPLEMENTATION_POSTFIX(                           \
+/* "_compare_used" is logical true, if "_less_expression" calls compare \
+   function, then functions, which compare elements, check that it is \
+   set. */ \
+#define NEDA_BODY_IMPLEMENTATION__GENERIC(                          \
     _postfix,                                                       \
     _type,                                                          \
-    _chunk_size)                                                    \
+    _chunk_size,                                                    \
+    _growth_policy,                                                 \
+    _less_expression,                                               \
+    _compare_used)                                                  \
   const nedasize_t NEDA_CHUNK_SIZE_##_postfix = _chunk_size;        \
   neda_##_postfix##__swap_function_type                             \
       neda_##_postfix##__swap_function_callback = 0;                \
@@ -220,16 +2046,30 @@ extern "C"
       neda_##_postfix##__compare_function_callback = 0;             \
   neda_##_postfix##__move_function_type                             \
       neda_##_postfix##__move_function_callback = 0;                \
+  neda_##_postfix##__growth_function_type                           \
+      neda_##_postfix##__growth_function_callback = 0;              \
+  /* First element is set by assignment, then filled part is        \
+     copied to rest of range with doubling "memcpy" calls, which    \
+     use vector instructions of C library. */                       \
   NEDA_API void neda_##_postfix##__memset(                          \
       _type *_data,                                                 \
       const _type _value,                                           \
       const nedasize_t _elem_count)                                 \
   {                                                                 \
-    nedasize_t i = 0;                                               \
-    while (i < _elem_count)                                         \
+    NEDA_REGISTER nedasize_t filled = 1;                            \
+    NEDA_REGISTER nedasize_t count;                                 \
+    if (!_elem_count)                                               \
     {                                                               \
-      _data[i] = _value;                                            \
-      i++;                                                          \
+      return;                                                       \
+    }                                                               \
+    _data[0] = _value;                                              \
+    while (filled < _elem_count)                                    \
+    {                                                               \
+      count = _elem_count - filled < filled                         \
+                  ? _elem_count - filled                            \
+                  : filled;                                         \
+      memcpy(_data + filled, _data, sizeof(_type) * count);         \
+      filled += count;                                              \
     }                                                               \
   }                                                                 \
   NEDA_API void neda_##_postfix##__byte_memset(                     \
@@ -237,23 +2077,133 @@ extern "C"
       const unsigned char _value,                                   \
       const nedasize_t _elem_count)                                 \
   {                                                                 \
-    nedasize_t i = 0;                                               \
-    while (i < (_elem_count * sizeof(_type)))                       \
+    memset(_data, _value, sizeof(_type) * _elem_count);             \
+  }                                                                 \
+  /* Prepares array in memory of caller (on stack or inside of      \
+     other struct), only data of array is allocated by              \
+     "_allocator". Such array is released by "destroy". */          \
+  NEDA_API void neda_##_postfix##__init_in_place_allocator(         \
+      struct neda_##_postfix *_da,                                  \
+      const struct neda_allocator *_allocator)                      \
+  {                                                                 \
+    NEDA_REGISTER nedasize_t i = 0;                                 \
+    NEDA_ASSERT(_da);                                               \
+    while (i < sizeof(neda_##_postfix))                             \
     {                                                               \
-      ((unsigned char *)(_data))[i] = _value;                       \
+      ((unsigned char *)_da)[i] = 0;                                \
       i++;                                                          \
     }                                                               \
+    _da->allocator = _allocator;                                    \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__init_in_place(                   \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    neda_##_postfix##__init_in_place_allocator(_da, 0);             \
+  }                                                                 \
+  /* Array and it's data are allocated by "_allocator". */          \
+  NEDA_API void neda_##_postfix##__init_allocator(                  \
+      struct neda_##_postfix **_da,                                 \
+      const struct neda_allocator *_allocator)                      \
+  {                                                                 \
+    *_da = (struct neda_##_postfix *)neda_allocate(                 \
+        _allocator,                                                 \
+        sizeof(neda_##_postfix));                                   \
+    NEDA_ASSERT(*_da);                                              \
+    neda_##_postfix##__init_in_place_allocator(*_da, _allocator);   \
   }                                                                 \
   NEDA_API void neda_##_postfix##__init(                            \
       struct neda_##_postfix **_da)                                 \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i = 0;                                 \
-    *_da = NEDA_MALLOC(sizeof(neda_##_postfix));                    \
-    NEDA_ASSERT(*_da);                                              \
-    while (i < sizeof(neda_##_postfix))                             \
+    neda_##_postfix##__init_allocator(_da, 0);                      \
+  }                                                                 \
+  /* Capacity, which array should get to store "_size" elements. */ \
+  NEDA_INTERNAL nedasize_t neda_##_postfix##__next_capacity(        \
+      const nedasize_t _capacity,                                   \
+      const nedasize_t _size)                                       \
+  {                                                                 \
+    NEDA_REGISTER nedasize_t geometric_capacity = 0;                \
+    NEDA_REGISTER nedasize_t chunk_capacity;                        \
+    switch (_growth_policy)                                         \
     {                                                               \
-      ((unsigned char *)*_da)[i] = 0;                               \
-      i++;                                                          \
+    case NEDA_GROWTH_GEOMETRIC_1_5:                                 \
+      geometric_capacity = _capacity + _capacity / 2;               \
+      break;                                                        \
+    case NEDA_GROWTH_GEOMETRIC_2:                                   \
+      geometric_capacity = _capacity * 2;                           \
+      break;                                                        \
+    case NEDA_GROWTH_CALLBACK:                                      \
+      if (neda_##_postfix##__growth_function_callback)              \
+      {                                                             \
+        geometric_capacity =                                        \
+            neda_##_postfix##__growth_function_callback(            \
+                _capacity,                                          \
+                _size);                                             \
+        NEDA_ASSERT(geometric_capacity >= _size);                   \
+        return geometric_capacity;                                  \
+      }                                                             \
+      break;                                                        \
+    default:                                                        \
+      break;                                                        \
+    }                                                               \
+    /* Geometric growth can overflow nedasize_t on huge arrays. */  \
+    if (geometric_capacity < _capacity)                             \
+    {                                                               \
+      geometric_capacity = 0;                                       \
+    }                                                               \
+    chunk_capacity = NEDA_CHUNK_RESERVE(                            \
+        NEDA_CHUNK_SIZE_##_postfix,                                 \
+        _size);                                                     \
+    return geometric_capacity > chunk_capacity                      \
+               ? geometric_capacity                                 \
+               : chunk_capacity;                                    \
+  }                                                                 \
+  /* Moves "_count" elements from "_source" to "_destination"       \
+     index, ranges may overlap. Uses one "memmove", if move         \
+     function was not set or it is the default one. */              \
+  NEDA_INTERNAL void neda_##_postfix##__move_range(                 \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _destination,                                \
+      const nedasize_t _source,                                     \
+      const nedasize_t _count)                                      \
+  {                                                                 \
+    NEDA_REGISTER nedasize_t i;                                     \
+    _type *_data = _da->data;                                       \
+    neda_##_postfix##__move_function_type move =                    \
+        _da->functions                                              \
+            ? _da->functions->move                                  \
+            : neda_##_postfix##__move_function_callback;            \
+    if (!_count)                                                    \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    if (!move || move == neda_##_postfix##__move_function_default)  \
+    {                                                               \
+      memmove(                                                      \
+          &_data[_destination],                                     \
+          &_data[_source],                                          \
+          sizeof(_type) * _count);                                  \
+    }                                                               \
+    else if (_destination < _source)                                \
+    {                                                               \
+      i = 0;                                                        \
+      while (i < _count)                                            \
+      {                                                             \
+        move(                                                       \
+            &_data[_destination + i],                               \
+            &_data[_source + i]);                                   \
+        i++;                                                        \
+      }                                                             \
+    }                                                               \
+    else if (_destination > _source)                                \
+    {                                                               \
+      i = _count;                                                   \
+      while (i > 0)                                                 \
+      {                                                             \
+        i--;                                                        \
+        move(                                                       \
+            &_data[_destination + i],                               \
+            &_data[_source + i]);                                   \
+      }                                                             \
     }                                                               \
   }                                                                 \
   NEDA_API void neda_##_postfix##__reserve(                         \
@@ -262,15 +2212,22 @@ extern "C"
   {                                                                 \
     NEDA_REGISTER nedasize_t new_capacity;                          \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
-    new_capacity = NEDA_CHUNK_RESERVE(                              \
-        NEDA_CHUNK_SIZE_##_postfix,                                 \
+    if ((_growth_policy) != NEDA_GROWTH_CHUNK &&                    \
+        _size <= _da->capacity)                                     \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    new_capacity = neda_##_postfix##__next_capacity(                \
+        _da->capacity,                                              \
         _size);                                                     \
     if (new_capacity > _da->capacity)                               \
     {                                                               \
-      _da->capacity = new_capacity;                                 \
-      _da->data = (_type *)NEDA_REALLOC(                            \
+      _da->data = (_type *)neda_reallocate(                         \
+          _da->allocator,                                           \
           _da->data,                                                \
-          sizeof(_type) * _da->capacity);                           \
+          sizeof(_type) * _da->capacity,                            \
+          sizeof(_type) * new_capacity);                            \
+      _da->capacity = new_capacity;                                 \
       NEDA_ASSERT(_da->data);                                       \
     }                                                               \
   }                                                                 \
@@ -315,19 +2272,15 @@ extern "C"
       struct neda_##_postfix *_da,                                  \
       const _type _value)                                           \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i;                                     \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     neda_##_postfix##__reserve(                                     \
         _da,                                                        \
         _da->size + 1);                                             \
-    i = _da->size;                                                  \
-    while (i > 0)                                                   \
-    {                                                               \
-      neda_##_postfix##__move_function_callback(                    \
-          &_da->data[i],                                            \
-          &_da->data[i - 1]);                                       \
-      i--;                                                          \
-    }                                                               \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        1,                                                          \
+        0,                                                          \
+        _da->size);                                                 \
     _da->data[0] = _value;                                          \
     _da->size++;                                                    \
   }                                                                 \
@@ -335,17 +2288,14 @@ extern "C"
       struct neda_##_postfix *_da)                                  \
   {                                                                 \
     _type result;                                                   \
-    NEDA_REGISTER nedasize_t i = 0;                                 \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     NEDA_ASSERT(_da->size);                                         \
     result = _da->data[0];                                          \
-    while (i < _da->size - 1)                                       \
-    {                                                               \
-      neda_##_postfix##__move_function_callback(                    \
-          &_da->data[i],                                            \
-          &_da->data[i + 1]);                                       \
-      i++;                                                          \
-    }                                                               \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        0,                                                          \
+        1,                                                          \
+        _da->size - 1);                                             \
     _da->size--;                                                    \
     return result;                                                  \
   }                                                                 \
@@ -367,7 +2317,6 @@ extern "C"
   NEDA_DEF void neda_##_postfix##__push_front_empty(                \
       struct neda_##_postfix *_da)                                  \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i;                                     \
     _type value;                                                    \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     neda_##_postfix##__byte_memset(                                 \
@@ -377,14 +2326,11 @@ extern "C"
     neda_##_postfix##__reserve(                                     \
         _da,                                                        \
         _da->size + 1);                                             \
-    i = _da->size;                                                  \
-    while (i > 0)                                              \
-    {                                                               \
-      neda_##_postfix##__move_function_callback(                    \
-          &_da->data[i],                                            \
-          &_da->data[i - 1]);                                       \
-      i--;                                                          \
-    }                                                               \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        1,                                                          \
+        0,                                                          \
+        _da->size);                                                 \
     _da->data[0] = value;                                           \
     _da->size++;                                                    \
   }                                                                 \
@@ -414,8 +2360,10 @@ extern "C"
         _da->size);                                                 \
     if (new_capacity < _da->capacity)                               \
     {                                                               \
-      _da->data = (_type *)NEDA_REALLOC(                            \
+      _da->data = (_type *)neda_reallocate(                         \
+          _da->allocator,                                           \
           _da->data,                                                \
+          sizeof(_type) * _da->capacity,                            \
           sizeof(_type) * new_capacity);                            \
       _da->capacity = new_capacity;                                 \
     }                                                               \
@@ -426,12 +2374,15 @@ extern "C"
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     if (_da->size == 0)                                             \
     {                                                               \
-      NEDA_FREE(_da->data);                                         \
+      neda_deallocate(_da->allocator, _da->data);                   \
+      _da->data = 0;                                                \
       _da->capacity = 0;                                            \
       return;                                                       \
     }                                                               \
-    _da->data = (_type *)NEDA_REALLOC(                              \
+    _da->data = (_type *)neda_reallocate(                           \
+        _da->allocator,                                             \
         _da->data,                                                  \
+        sizeof(_type) * _da->capacity,                              \
         sizeof(_type) * _da->size);                                 \
     _da->capacity = _da->size;                                      \
   }                                                                 \
@@ -440,20 +2391,16 @@ extern "C"
       const nedasize_t _index,                                      \
       const _type _value)                                           \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i;                                     \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     NEDA_ASSERT(_da->size + 1 > _index);                            \
     neda_##_postfix##__reserve(                                     \
         _da,                                                        \
         _da->size + 1);                                             \
-    i = _da->size;                                                  \
-    while (i > _index)                                              \
-    {                                                               \
-      neda_##_postfix##__move_function_callback(                    \
-          &_da->data[i],                                            \
-          &_da->data[i - 1]);                                       \
-      i--;                                                          \
-    }                                                               \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        _index + 1,                                                 \
+        _index,                                                     \
+        _da->size - _index);                                        \
     _da->data[_index] = _value;                                     \
     _da->size++;                                                    \
   }                                                                 \
@@ -461,58 +2408,235 @@ extern "C"
       struct neda_##_postfix *_da,                                  \
       const nedasize_t _index)                                      \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i;                                     \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     NEDA_ASSERT(_da->size > _index);                                \
-    i = _index;                                                     \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        _index,                                                     \
+        _index + 1,                                                 \
+        _da->size - _index - 1);                                    \
+    _da->size--;                                                    \
+  }                                                                 \
+  /* \returns logical true, if "_values" points into storage of     \
+     "_da", then "*_offset" is index of element it points to. */    \
+  NEDA_INTERNAL int neda_##_postfix##__aliases(                     \
+      const struct neda_##_postfix *_da,                            \
+      const _type *_values,                                         \
+      nedasize_t *_offset)                                          \
+  {                                                                 \
+    if (!_da->data ||                                               \
+        _values < _da->data ||                                      \
+        _values >= _da->data + _da->capacity)                       \
+    {                                                               \
+      return 0;                                                     \
+    }                                                               \
+    *_offset = (nedasize_t)(_values - _da->data);                   \
+    return 1;                                                       \
+  }                                                                 \
+  /* "_values" may point to elements of "_da" itself, they are      \
+     read after reallocation from new storage. */                   \
+  NEDA_API void neda_##_postfix##__append_n(                        \
+      struct neda_##_postfix *_da,                                  \
+      const _type *_values,                                         \
+      const nedasize_t _count)                                      \
+  {                                                                 \
+    nedasize_t offset = 0;                                          \
+    int aliased;                                                    \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(_values || !_count);                                \
+    if (!_count)                                                    \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    aliased = neda_##_postfix##__aliases(_da, _values, &offset);    \
+    NEDA_ASSERT(!aliased || offset + _count <= _da->size);          \
+    neda_##_postfix##__reserve(                                     \
+        _da,                                                        \
+        _da->size + _count);                                        \
+    if (aliased)                                                    \
+    {                                                               \
+      _values = _da->data + offset;                                 \
+    }                                                               \
+    memcpy(                                                         \
+        &_da->data[_da->size],                                      \
+        _values,                                                    \
+        sizeof(_type) * _count);                                    \
+    _da->size += _count;                                            \
+  }                                                                 \
+  /* "_values" may point to elements of "_da" itself. Then part of  \
+     them before "_index" stays in place and the rest is shifted    \
+     with the tail, so they are copied in two parts. */             \
+  NEDA_API void neda_##_postfix##__insert_range(                    \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _index,                                      \
+      const _type *_values,                                         \
+      const nedasize_t _count)                                      \
+  {                                                                 \
+    nedasize_t offset = 0, head;                                    \
+    int aliased;                                                    \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(_da->size >= _index);                               \
+    NEDA_ASSERT(_values || !_count);                                \
+    if (!_count)                                                    \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    aliased = neda_##_postfix##__aliases(_da, _values, &offset);    \
+    NEDA_ASSERT(!aliased || offset + _count <= _da->size);          \
+    neda_##_postfix##__reserve(                                     \
+        _da,                                                        \
+        _da->size + _count);                                        \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        _index + _count,                                            \
+        _index,                                                     \
+        _da->size - _index);                                        \
+    if (!aliased)                                                   \
+    {                                                               \
+      memcpy(                                                       \
+          &_da->data[_index],                                       \
+          _values,                                                  \
+          sizeof(_type) * _count);                                  \
+    }                                                               \
+    else if (offset < _index)                                       \
+    {                                                               \
+      head = _index - offset < _count ? _index - offset : _count;   \
+      memcpy(                                                       \
+          &_da->data[_index],                                       \
+          &_da->data[offset],                                       \
+          sizeof(_type) * head);                                    \
+      memcpy(                                                       \
+          &_da->data[_index + head],                                \
+          &_da->data[_index + _count],                              \
+          sizeof(_type) * (_count - head));                         \
+    }                                                               \
+    else                                                            \
+    {                                                               \
+      memcpy(                                                       \
+          &_da->data[_index],                                       \
+          &_da->data[offset + _count],                              \
+          sizeof(_type) * _count);                                  \
+    }                                                               \
+    _da->size += _count;                                            \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__erase_range(                     \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _first,                                      \
+      const nedasize_t _last)                                       \
+  {                                                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(_first <= _last && _last <= _da->size);             \
+    neda_##_postfix##__move_range(                                  \
+        _da,                                                        \
+        _first,                                                     \
+        _last,                                                      \
+        _da->size - _last);                                         \
+    _da->size -= _last - _first;                                    \
+  }                                                                 \
+  /* Moves kept elements [_first; _last) to "*_write" by one block  \
+     move and advances "*_write". */                                \
+  NEDA_INTERNAL void neda_##_postfix##__compact_run(                \
+      struct neda_##_postfix *_da,                                  \
+      nedasize_t *_write,                                           \
+      const nedasize_t _first,                                      \
+      const nedasize_t _last)                                       \
+  {                                                                 \
+    if (*_write != _first)                                          \
+    {                                                               \
+      neda_##_postfix##__move_range(                                \
+          _da,                                                      \
+          *_write,                                                  \
+          _first,                                                   \
+          _last - _first);                                          \
+    }                                                               \
+    *_write += _last - _first;                                      \
+  }                                                                 \
+  /* Removes all elements, for which "_predicate" returns logical   \
+     true, in one pass. Every kept element is moved at most once.   \
+     \returns count of removed elements. */                         \
+  NEDA_API nedasize_t neda_##_postfix##__remove_if(                 \
+      struct neda_##_postfix *_da,                                  \
+      neda_##_postfix##__predicate_function_type _predicate,        \
+      void *_context)                                               \
+  {                                                                 \
+    NEDA_REGISTER nedasize_t i = 0;                                 \
+    nedasize_t first = 0, write = 0, removed;                       \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(_predicate);                                        \
     while (i < _da->size)                                           \
     {                                                               \
-      neda_##_postfix##__move_function_callback(                    \
-          &_da->data[i],                                            \
-          &_da->data[i + 1]);                                       \
+      if (_predicate(&_da->data[i], _context))                      \
+      {                                                             \
+        neda_##_postfix##__compact_run(_da, &write, first, i);      \
+        first = i + 1;                                              \
+      }                                                             \
       i++;                                                          \
     }                                                               \
-    _da->size--;                                                    \
+    neda_##_postfix##__compact_run(_da, &write, first, _da->size);  \
+    removed = _da->size - write;                                    \
+    _da->size = write;                                              \
+    return removed;                                                 \
   }                                                                 \
-  NEDA_API void neda_##_postfix##__fill(                            \
+  /* Keeps only elements with "_count" given indices, which should  \
+     be strictly increasing. \returns count of removed elements. */ \
+  NEDA_API nedasize_t neda_##_postfix##__retain_indices(            \
       struct neda_##_postfix *_da,                                  \
-      const _type _value)                                           \
+      const nedasize_t *_indices,                                   \
+      const nedasize_t _count)                                      \
   {                                                                 \
     NEDA_REGISTER nedasize_t i = 0;                                 \
+    nedasize_t first, last, write = 0, removed;                     \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
-    while (i < _da->size)                                           \
+    NEDA_ASSERT(_indices || !_count);                               \
+    while (i < _count)                                              \
     {                                                               \
-      _da->data[i] = _value;                                        \
+      first = _indices[i];                                          \
+      last = first + 1;                                             \
       i++;                                                          \
+      /* Consecutive indices are moved as one block. */             \
+      while (i < _count && _indices[i] == last)                     \
+      {                                                             \
+        last++;                                                     \
+        i++;                                                        \
+      }                                                             \
+      NEDA_ASSERT(last <= _da->size);                               \
+      NEDA_ASSERT(i == _count || _indices[i] > last);               \
+      neda_##_postfix##__compact_run(_da, &write, first, last);     \
     }                                                               \
+    removed = _da->size - write;                                    \
+    _da->size = write;                                              \
+    return removed;                                                 \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__fill(                            \
+      struct neda_##_postfix *_da,                                  \
+      const _type _value)                                           \
+  {                                                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__memset(_da->data, _value, _da->size);        \
   }                                                                 \
   NEDA_API void neda_##_postfix##__fill_size(                       \
       struct neda_##_postfix *_da,                                  \
       const nedasize_t _size,                                       \
       const _type _value)                                           \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i = 0;                                 \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
     neda_##_postfix##__reserve(_da, _size);                         \
-    while (i < _size)                                               \
-    {                                                               \
-      _da->data[i] = _value;                                        \
-      i++;                                                          \
-    }                                                               \
+    neda_##_postfix##__memset(_da->data, _value, _size);            \
     _da->size = _size;                                              \
   }                                                                 \
   NEDA_API void neda_##_postfix##__copy(                            \
       struct neda_##_postfix *_source,                              \
       struct neda_##_postfix *_destination)                         \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i = 0;                                 \
     NEDA_ASSERT(!NEDA_VALIDATE(_source));                           \
     NEDA_ASSERT(!NEDA_VALIDATE(_destination));                      \
     neda_##_postfix##__reserve(_destination, _source->size);        \
-    while (i < _source->size)                                       \
+    if (_source->size)                                              \
     {                                                               \
-      _destination->data[i] = _source->data[i];                     \
-      i++;                                                          \
+      memcpy(                                                       \
+          _destination->data,                                       \
+          _source->data,                                            \
+          sizeof(_type) * _source->size);                           \
     }                                                               \
     _destination->size = _source->size;                             \
   }                                                                 \
@@ -588,125 +2712,3712 @@ extern "C"
   {                                                                 \
     neda_##_postfix##__move_function_callback = _move_function;     \
   }                                                                 \
+  NEDA_API void neda_##_postfix##__set_growth_function(             \
+      neda_##_postfix##__growth_function_type _growth_function)     \
+  {                                                                 \
+    neda_##_postfix##__growth_function_callback = _growth_function; \
+  }                                                                 \
   NEDA_API void neda_##_postfix##__set_default_functions()          \
   {                                                                 \
     neda_##_postfix##__set_default_compare_function();              \
     neda_##_postfix##__set_default_swap_function();                 \
     neda_##_postfix##__set_default_move_function();                 \
   }                                                                 \
+  NEDA_API const struct neda_##_postfix##__functions *              \
+      neda_##_postfix##__default_functions()                        \
+  {                                                                 \
+    static const struct neda_##_postfix##__functions functions = {  \
+        neda_##_postfix##__compare_function_default,                \
+        neda_##_postfix##__swap_function_default,                   \
+        neda_##_postfix##__move_function_default};                  \
+    return &functions;                                              \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__set_functions(                   \
+      struct neda_##_postfix *_da,                                  \
+      const struct neda_##_postfix##__functions *_functions)        \
+  {                                                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    _da->functions = _functions;                                    \
+  }                                                                 \
+  /* Functions of "_da": it's own table, if it was set, or global   \
+     callbacks otherwise. It is used by every function, which       \
+     compares elements, so compare function is checked here. */     \
+  NEDA_INTERNAL void neda_##_postfix##__get_functions(              \
+      const struct neda_##_postfix *_da,                            \
+      struct neda_##_postfix##__functions *_functions)              \
+  {                                                                 \
+    if (_da->functions)                                             \
+    {                                                               \
+      *_functions = *_da->functions;                                \
+    }                                                               \
+    else                                                            \
+    {                                                               \
+      _functions->compare =                                         \
+          neda_##_postfix##__compare_function_callback;             \
+      _functions->swap = neda_##_postfix##__swap_function_callback; \
+      _functions->move = neda_##_postfix##__move_function_callback; \
+    }                                                               \
+    NEDA_ASSERT(!(_compare_used) || _functions->compare);           \
+  }                                                                 \
+  /* "sort" places "_a" before "_b", if "_less_expression" is true. \
+     By default it is compare(_a, _b) > 0. */                       \
+  NEDA_INTERNAL int neda_##_postfix##__less(                        \
+      const struct neda_##_postfix##__functions *_functions,        \
+      const _type *_a,                                              \
+      const _type *_b)                                              \
+  {                                                                 \
+    NEDA_UNUSED(_functions);                                        \
+    return (_less_expression);                                      \
+  }                                                                 \
+  /* "quick_sort" keeps it's old order: "_a" is placed after "_b",  \
+     if compare(_a, _b) > 0. */                                     \
+  NEDA_INTERNAL int neda_##_postfix##__less_reverse(                \
+      const struct neda_##_postfix##__functions *_functions,        \
+      const _type *_a,                                              \
+      const _type *_b)                                              \
+  {                                                                 \
+    return neda_##_postfix##__less(_functions, _b, _a);             \
+  }                                                                 \
+  NEDA_SORT_ENGINE(                                                 \
+      neda_##_postfix##__sort_engine,                               \
+      _type,                                                        \
+      struct neda_##_postfix##__functions,                          \
+      neda_##_postfix##__less)                                      \
+  NEDA_SORT_ENGINE(                                                 \
+      neda_##_postfix##__quick_sort_engine,                         \
+      _type,                                                        \
+      struct neda_##_postfix##__functions,                          \
+      neda_##_postfix##__less_reverse)                              \
+  /* \returns logical true, if swap or move function of             \
+     "_functions" is set and it is not the default one. Then        \
+     sorting uses them instead of assignment. */                    \
+  NEDA_INTERNAL int neda_##_postfix##__callbacks_used(              \
+      const struct neda_##_postfix##__functions *_functions)        \
+  {                                                                 \
+    return (_functions->swap &&                                     \
+            _functions->swap !=                                     \
+                neda_##_postfix##__swap_function_default) ||        \
+           (_functions->move &&                                     \
+            _functions->move !=                                     \
+                neda_##_postfix##__move_function_default);          \
+  }                                                                 \
+  NEDA_INTERNAL void neda_##_postfix##__callback_move(              \
+      const struct neda_##_postfix##__functions *_functions,        \
+      _type *_destination,                                          \
+      _type *_source)                                               \
+  {                                                                 \
+    if (_functions->move)                                           \
+    {                                                               \
+      _functions->move(_destination, _source);                      \
+    }                                                               \
+    else                                                            \
+    {                                                               \
+      *_destination = *_source;                                     \
+    }                                                               \
+  }                                                                 \
+  NEDA_INTERNAL void neda_##_postfix##__callback_swap(              \
+      const struct neda_##_postfix##__functions *_functions,        \
+      _type *_a,                                                    \
+      _type *_b)                                                    \
+  {                                                                 \
+    _type temp;                                                     \
+    if (_functions->swap)                                           \
+    {                                                               \
+      _functions->swap(_a, _b);                                     \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__callback_move(_functions, &temp, _a);        \
+    neda_##_postfix##__callback_move(_functions, _a, _b);           \
+    neda_##_postfix##__callback_move(_functions, _b, &temp);        \
+  }                                                                 \
+  NEDA_SORT_ENGINE_MOVE(                                            \
+      neda_##_postfix##__callback_sort_engine,                      \
+      _type,                                                        \
+      struct neda_##_postfix##__functions,                          \
+      neda_##_postfix##__less,                                      \
+      neda_##_postfix##__callback_move,                             \
+      neda_##_postfix##__callback_swap)                             \
+  NEDA_SORT_ENGINE_MOVE(                                            \
+      neda_##_postfix##__callback_quick_sort_engine,                \
+      _type,                                                        \
+      struct neda_##_postfix##__functions,                          \
+      neda_##_postfix##__less_reverse,                              \
+      neda_##_postfix##__callback_move,                             \
+      neda_##_postfix##__callback_swap)                             \
   NEDA_API void neda_##_postfix##__sort(                            \
       struct neda_##_postfix *_da)                                  \
   {                                                                 \
-    NEDA_REGISTER nedasize_t i_o = 0;                               \
-    NEDA_REGISTER nedasize_t i_s = 0;                               \
-    NEDA_REGISTER nedasize_t swap_index = 0;                        \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    if (neda_##_postfix##__callbacks_used(&functions))              \
+    {                                                               \
+      neda_##_postfix##__callback_sort_engine_range(                \
+          _da->data,                                                \
+          _da->data + _da->size,                                    \
+          &functions);                                              \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__sort_engine_range(                           \
+        _da->data,                                                  \
+        _da->data + _da->size,                                      \
+        &functions);                                                \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__quick_sort(                      \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
     NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
-    NEDA_ASSERT(neda_##_postfix##__compare_function_callback);      \
-    NEDA_ASSERT(neda_##_postfix##__swap_function_callback);         \
-    while (i_o < _da->size)                                         \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    if (neda_##_postfix##__callbacks_used(&functions))              \
     {                                                               \
-      swap_index = _da->size - 1;                                   \
-      i_s = i_o;                                                    \
-      while (i_s < _da->size)                                       \
+      neda_##_postfix##__callback_quick_sort_engine_range(          \
+          _da->data,                                                \
+          _da->data + _da->size,                                    \
+          &functions);                                              \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__quick_sort_engine_range(                     \
+        _da->data,                                                  \
+        _da->data + _da->size,                                      \
+        &functions);                                                \
+  }                                                                 \
+  NEDA_STABLE_SORT_ENGINE(                                          \
+      neda_##_postfix##__stable_sort_engine,                        \
+      _type,                                                        \
+      struct neda_##_postfix##__functions,                          \
+      neda_##_postfix##__less)                                      \
+  /* Scratch for half of array is taken from allocator of array, it \
+     is not allocated, if array is one run already. */              \
+  NEDA_API void neda_##_postfix##__stable_sort(                     \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    _type *scratch = 0;                                             \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    if (_da->size < 2)                                              \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    if (neda_##_postfix##__stable_sort_engine_count_run(            \
+            _da->data,                                              \
+            _da->data + _da->size,                                  \
+            &functions) == _da->size)                               \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    if (_da->size >= NEDA_STABLE_SORT_MIN_MERGE)                    \
+    {                                                               \
+      scratch = (_type *)neda_allocate(                             \
+          _da->allocator,                                           \
+          sizeof(_type) * (_da->size / 2));                         \
+      NEDA_ASSERT(scratch);                                         \
+    }                                                               \
+    neda_##_postfix##__stable_sort_engine_range(                    \
+        _da->data,                                                  \
+        _da->data + _da->size,                                      \
+        scratch,                                                    \
+        &functions);                                                \
+    if (scratch)                                                    \
+    {                                                               \
+      neda_deallocate(_da->allocator, scratch);                     \
+    }                                                               \
+  }                                                                 \
+  /* Reorders array in O(n), so element "_nth" is the same as after \
+     "sort", elements before it are not greater and elements after  \
+     it are not less. */                                            \
+  NEDA_API void neda_##_postfix##__nth_element(                     \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _nth)                                        \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(_nth < _da->size);                                  \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    if (neda_##_postfix##__callbacks_used(&functions))              \
+    {                                                               \
+      neda_##_postfix##__callback_sort_engine_select(               \
+          _da->data,                                                \
+          _da->data + _nth,                                         \
+          _da->data + _da->size,                                    \
+          &functions);                                              \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__sort_engine_select(                          \
+        _da->data,                                                  \
+        _da->data + _nth,                                           \
+        _da->data + _da->size,                                      \
+        &functions);                                                \
+  }                                                                 \
+  /* Places first "_count" elements of sorted array at beginning in \
+     sorted order, order of the rest is unspecified. Takes          \
+     O(n + k log k) time. */                                        \
+  NEDA_API void neda_##_postfix##__partial_sort(                    \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _count)                                      \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    if (neda_##_postfix##__callbacks_used(&functions))              \
+    {                                                               \
+      if (_count < _da->size)                                       \
       {                                                             \
-        if (neda_##_postfix##__compare_function_callback(           \
-                &_da->data[i_s],                                    \
-                &_da->data[swap_index]))                            \
-        {                                                           \
-          swap_index = i_s;                                         \
-        }                                                           \
-        i_s++;                                                      \
+        neda_##_postfix##__callback_sort_engine_select(             \
+            _da->data,                                              \
+            _da->data + _count,                                     \
+            _da->data + _da->size,                                  \
+            &functions);                                            \
       }                                                             \
-      neda_##_postfix##__swap_function_callback(                    \
-          &_da->data[i_o],                                          \
-          &_da->data[swap_index]);                                  \
-      i_o++;                                                        \
+      neda_##_postfix##__callback_sort_engine_range(                \
+          _da->data,                                                \
+          _da->data + (_count < _da->size ? _count : _da->size),    \
+          &functions);                                              \
+      return;                                                       \
+    }                                                               \
+    if (_count < _da->size)                                         \
+    {                                                               \
+      neda_##_postfix##__sort_engine_select(                        \
+          _da->data,                                                \
+          _da->data + _count,                                       \
+          _da->data + _da->size,                                    \
+          &functions);                                              \
     }                                                               \
+    neda_##_postfix##__sort_engine_range(                           \
+        _da->data,                                                  \
+        _da->data + (_count < _da->size ? _count : _da->size),      \
+        &functions);                                                \
   }                                                                 \
-  /* Original of this function was made by Darel Rex Finley. */     \
-  void neda_##_postfix##__quick_sort(                               \
-      struct neda_##_postfix *_da)                                  \
+  /* "_top" is heap of "_k" first elements in sort order, it's root \
+     is the last of them, so new value is compared with one         \
+     element. */                                                    \
+  NEDA_INTERNAL void neda_##_postfix##__top_k_insert(               \
+      struct neda_##_postfix *_top,                                 \
+      const nedasize_t _k,                                          \
+      const _type _value,                                           \
+      const struct neda_##_postfix##__functions *_functions)        \
   {                                                                 \
-    int beg[NEDA_QUICK_SORT_MAX_LEVELS];                            \
-    int end[NEDA_QUICK_SORT_MAX_LEVELS];                            \
-    NEDA_REGISTER int i = 0, left, right, swap;                     \
-    _type piv;                                                      \
-    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
-    NEDA_ASSERT(neda_##_postfix##__compare_function_callback);      \
-    NEDA_ASSERT(neda_##_postfix##__swap_function_callback);         \
-    NEDA_ASSERT(neda_##_postfix##__move_function_callback);         \
-    beg[0] = 0;                                                     \
-    end[0] = _da->size;                                             \
-    while (i >= 0)                                                  \
-    {                                                               \
-      left = beg[i];                                                \
-      right = end[i] - 1;                                           \
-      if (left < right)                                             \
+    NEDA_REGISTER nedasize_t index, parent;                         \
+    if (_top->size < _k)                                            \
+    {                                                               \
+      neda_##_postfix##__push_back(_top, _value);                   \
+      index = _top->size - 1;                                       \
+      while (index > 0)                                             \
       {                                                             \
-        neda_##_postfix##__move_function_callback(                  \
-            &piv,                                                   \
-            &_da->data[left]);                                      \
-        while (left < right)                                        \
-        {                                                           \
-          while (neda_##_postfix##__compare_function_callback(      \
-                     &_da->data[right],                             \
-                     &piv) > 0 &&                                   \
-                 left < right)                                      \
-            right--;                                                \
-          if (left < right)                                         \
-            neda_##_postfix##__move_function_callback(              \
-                &_da->data[left++],                                 \
-                &_da->data[right]);                                 \
-          while (neda_##_postfix##__compare_function_callback(      \
-                     &piv,                                          \
-                     &_da->data[left]) > 0 &&                       \
-                 left < right)                                      \
-            left++;                                                 \
-          if (left < right)                                         \
-            neda_##_postfix##__move_function_callback(              \
-                &_da->data[right--],                                \
-                &_da->data[left]);                                  \
-        }                                                           \
-        neda_##_postfix##__move_function_callback(                  \
-            &_da->data[left],                                       \
-            &piv);                                                  \
-        beg[i + 1] = left + 1;                                      \
-        end[i + 1] = end[i];                                        \
-        end[i++] = left;                                            \
-        if (end[i] - beg[i] > end[i - 1] - beg[i - 1])              \
+        parent = (index - 1) / 2;                                   \
+        if (!neda_##_postfix##__less(                               \
+                _functions,                                         \
+                &_top->data[parent],                                \
+                &_value))                                           \
         {                                                           \
-          swap = beg[i];                                            \
-          beg[i] = beg[i - 1];                                      \
-          beg[i - 1] = swap;                                        \
-          swap = end[i];                                            \
-          end[i] = end[i - 1];                                      \
-          end[i - 1] = swap;                                        \
+          break;                                                    \
         }                                                           \
+        _top->data[index] = _top->data[parent];                     \
+        index = parent;                                             \
       }                                                             \
-      else                                                          \
+      _top->data[index] = _value;                                   \
+    }                                                               \
+    else if (_k && neda_##_postfix##__less(                         \
+                       _functions,                                  \
+                       &_value,                                     \
+                       &_top->data[0]))                             \
+    {                                                               \
+      _top->data[0] = _value;                                       \
+      neda_##_postfix##__sort_engine_sift_down(                     \
+          _top->data,                                               \
+          0,                                                        \
+          _top->size,                                               \
+          _functions);                                              \
+    }                                                               \
+  }                                                                 \
+  /* Streaming top-k: keeps in "_top" "_k" first of pushed values   \
+     in sort order. "_top" is heap, so it should be empty or filled \
+     only by "top_k_push". It can be sorted by "sort" at the        \
+     end. */                                                        \
+  NEDA_API void neda_##_postfix##__top_k_push(                      \
+      struct neda_##_postfix *_top,                                 \
+      const nedasize_t _k,                                          \
+      const _type _value)                                           \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_top));                              \
+    NEDA_ASSERT(_top->size <= _k);                                  \
+    neda_##_postfix##__get_functions(_top, &functions);             \
+    neda_##_postfix##__top_k_insert(_top, _k, _value, &functions);  \
+  }                                                                 \
+  /* Replaces content of "_top" by "_k" first elements of sorted    \
+     "_da" in sorted order. "_da" is not changed. */                \
+  NEDA_API void neda_##_postfix##__top_k(                           \
+      struct neda_##_postfix *_da,                                  \
+      const nedasize_t _k,                                          \
+      struct neda_##_postfix *_top)                                 \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_REGISTER nedasize_t i = 0;                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(!NEDA_VALIDATE(_top));                              \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    neda_##_postfix##__clear(_top);                                 \
+    while (i < _da->size)                                           \
+    {                                                               \
+      neda_##_postfix##__top_k_insert(                              \
+          _top,                                                     \
+          _k,                                                       \
+          _da->data[i],                                             \
+          &functions);                                              \
+      i++;                                                          \
+    }                                                               \
+    neda_##_postfix##__sort_engine_heap_sort(                       \
+        _top->data,                                                 \
+        _top->data + _top->size,                                    \
+        &functions);                                                \
+  }                                                                 \
+  /* \returns index of first element of sorted range, which is not  \
+     less than "_value". Branch in loop is replaced by conditional  \
+     move, so search does not suffer from mispredictions. */        \
+  NEDA_INTERNAL nedasize_t neda_##_postfix##__lower_bound_range(    \
+      const _type *_data,                                           \
+      nedasize_t _size,                                             \
+      const _type *_value,                                          \
+      const struct neda_##_postfix##__functions *_functions)        \
+  {                                                                 \
+    const _type *base = _data;                                      \
+    NEDA_REGISTER nedasize_t half;                                  \
+    int less;                                                       \
+    if (!_size)                                                     \
+    {                                                               \
+      return 0;                                                     \
+    }                                                               \
+    while (_size > 1)                                               \
+    {                                                               \
+      half = _size / 2;                                             \
+      less = neda_##_postfix##__less(                               \
+          _functions,                                               \
+          &base[half],                                              \
+          _value);                                                  \
+      base = less ? base + half : base;                             \
+      _size -= half;                                                \
+    }                                                               \
+    less = neda_##_postfix##__less(_functions, base, _value);       \
+    return (nedasize_t)(base - _data) + (less ? 1 : 0);             \
+  }                                                                 \
+  /* \returns index of first element of sorted range, which is      \
+     greater than "_value". */                                      \
+  NEDA_INTERNAL nedasize_t neda_##_postfix##__upper_bound_range(    \
+      const _type *_data,                                           \
+      nedasize_t _size,                                             \
+      const _type *_value,                                          \
+      const struct neda_##_postfix##__functions *_functions)        \
+  {                                                                 \
+    const _type *base = _data;                                      \
+    NEDA_REGISTER nedasize_t half;                                  \
+    int greater;                                                    \
+    if (!_size)                                                     \
+    {                                                               \
+      return 0;                                                     \
+    }                                                               \
+    while (_size > 1)                                               \
+    {                                                               \
+      half = _size / 2;                                             \
+      greater = neda_##_postfix##__less(                            \
+          _functions,                                               \
+          _value,                                                   \
+          &base[half]);                                             \
+      base = greater ? base : base + half;                          \
+      _size -= half;                                                \
+    }                                                               \
+    greater = neda_##_postfix##__less(_functions, _value, base);    \
+    return (nedasize_t)(base - _data) + (greater ? 0 : 1);          \
+  }                                                                 \
+  NEDA_API nedasize_t neda_##_postfix##__lower_bound(               \
+      struct neda_##_postfix *_da,                                  \
+      const _type _value)                                           \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    return neda_##_postfix##__lower_bound_range(                    \
+        _da->data,                                                  \
+        _da->size,                                                  \
+        &_value,                                                    \
+        &functions);                                                \
+  }                                                                 \
+  NEDA_API nedasize_t neda_##_postfix##__upper_bound(               \
+      struct neda_##_postfix *_da,                                  \
+      const _type _value)                                           \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    return neda_##_postfix##__upper_bound_range(                    \
+        _da->data,                                                  \
+        _da->size,                                                  \
+        &_value,                                                    \
+        &functions);                                                \
+  }                                                                 \
+  /* Elements equal to "_value" are in [_first; _last) range. */    \
+  NEDA_API void neda_##_postfix##__equal_range(                     \
+      struct neda_##_postfix *_da,                                  \
+      const _type _value,                                           \
+      nedasize_t *_first,                                           \
+      nedasize_t *_last)                                            \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    *_first = neda_##_postfix##__lower_bound_range(                 \
+        _da->data,                                                  \
+        _da->size,                                                  \
+        &_value,                                                    \
+        &functions);                                                \
+    *_last = *_first + neda_##_postfix##__upper_bound_range(        \
+                           _da->data + *_first,                     \
+                           _da->size - *_first,                     \
+                           &_value,                                 \
+                           &functions);                             \
+  }                                                                 \
+  /* Inserts "_value" after equal elements, so sorted array stays   \
+     sorted. \returns index of inserted element. */                 \
+  NEDA_API nedasize_t neda_##_postfix##__insert_sorted(             \
+      struct neda_##_postfix *_da,                                  \
+      const _type _value)                                           \
+  {                                                                 \
+    NEDA_REGISTER nedasize_t index;                                 \
+    index = neda_##_postfix##__upper_bound(_da, _value);            \
+    neda_##_postfix##__insert(_da, index, _value);                  \
+    return index;                                                   \
+  }                                                                 \
+  /* Removes all but first element of every group of equal elements \
+     of sorted array in one pass. \returns count of removed         \
+     elements. */                                                   \
+  NEDA_API nedasize_t neda_##_postfix##__unique(                    \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_REGISTER nedasize_t i = 1;                                 \
+    nedasize_t first = 0, write = 0, removed;                       \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_##_postfix##__get_functions(_da, &functions);              \
+    /* Kept runs are moved only when they end, so previous element  \
+       is still in it's place, when it is compared. */              \
+    while (i < _da->size)                                           \
+    {                                                               \
+      if (!neda_##_postfix##__less(                                 \
+              &functions,                                           \
+              &_da->data[i - 1],                                    \
+              &_da->data[i]))                                       \
       {                                                             \
-        i--;                                                        \
+        neda_##_postfix##__compact_run(_da, &write, first, i);      \
+        first = i + 1;                                              \
       }                                                             \
+      i++;                                                          \
     }                                                               \
+    if (_da->size)                                                  \
+    {                                                               \
+      neda_##_postfix##__compact_run(                               \
+          _da,                                                      \
+          &write,                                                   \
+          first,                                                    \
+          _da->size);                                               \
+    }                                                               \
+    removed = _da->size - write;                                    \
+    _da->size = write;                                              \
+    return removed;                                                 \
   }                                                                 \
-  NEDA_API void neda_##_type##__clear(                              \
-      struct neda_##_type *_dynamic_array)                          \
+  /* Places sorted "_source" elements to "_layout" by in-order      \
+     traversal of implicit tree, where children of k are 2k and     \
+     2k + 1. */                                                     \
+  NEDA_INTERNAL void neda_##_postfix##__eytzinger_fill(             \
+      const _type *_source,                                         \
+      _type *_layout,                                               \
+      nedasize_t *_index,                                           \
+      const nedasize_t _node,                                       \
+      const nedasize_t _size)                                       \
   {                                                                 \
-    NEDA_ASSERT(!NEDA_VALIDATE(_dynamic_array));                    \
-    _dynamic_array->size = 0;                                       \
+    if (_node > _size)                                              \
+    {                                                               \
+      return;                                                       \
+    }                                                               \
+    neda_##_postfix##__eytzinger_fill(                              \
+        _source,                                                    \
+        _layout,                                                    \
+        _index,                                                     \
+        _node * 2,                                                  \
+        _size);                                                     \
+    _layout[_node - 1] = _source[(*_index)++];                      \
+    neda_##_postfix##__eytzinger_fill(                              \
+        _source,                                                    \
+        _layout,                                                    \
+        _index,                                                     \
+        _node * 2 + 1,                                              \
+        _size);                                                     \
+  }                                                                 \
+  /* Copies sorted "_da" to "_layout" in Eytzinger (BFS) order.     \
+     Top levels of tree are in first cache lines, so search over    \
+     big read-mostly arrays makes less cache misses. */             \
+  NEDA_API void neda_##_postfix##__eytzinger_build(                 \
+      struct neda_##_postfix *_da,                                  \
+      struct neda_##_postfix *_layout)                              \
+  {                                                                 \
+    nedasize_t index = 0;                                           \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    NEDA_ASSERT(!NEDA_VALIDATE(_layout));                           \
+    neda_##_postfix##__reserve(_layout, _da->size);                 \
+    neda_##_postfix##__eytzinger_fill(                              \
+        _da->data,                                                  \
+        _layout->data,                                              \
+        &index,                                                     \
+        1,                                                          \
+        _da->size);                                                 \
+    _layout->size = _da->size;                                      \
+  }                                                                 \
+  /* \returns index in "_layout" of first element, which is not     \
+     less than "_value", or size of "_layout", if there is no such  \
+     one. */                                                        \
+  NEDA_API nedasize_t neda_##_postfix##__eytzinger_lower_bound(     \
+      struct neda_##_postfix *_layout,                              \
+      const _type _value)                                           \
+  {                                                                 \
+    struct neda_##_postfix##__functions functions;                  \
+    NEDA_REGISTER nedasize_t node = 1;                              \
+    NEDA_ASSERT(!NEDA_VALIDATE(_layout));                           \
+    neda_##_postfix##__get_functions(_layout, &functions);          \
+    while (node <= _layout->size)                                   \
+    {                                                               \
+      NEDA_PREFETCH((const char *)_layout->data +                   \
+                    sizeof(_type) * (node * 16 - 1));               \
+      node = node * 2 + (neda_##_postfix##__less(                   \
+                             &functions,                            \
+                             &_layout->data[node - 1],              \
+                             &_value)                               \
+                             ? 1                                    \
+                             : 0);                                  \
+    }                                                               \
+    /* Right turns at the end of path are dropped, last left turn   \
+       is the answer. */                                            \
+    while (node & 1)                                                \
+    {                                                               \
+      node >>= 1;                                                   \
+    }                                                               \
+    node >>= 1;                                                     \
+    return node ? node - 1 : _layout->size;                         \
+  }                                                                 \
+  NEDA_API void neda_##_postfix##__clear(                           \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    _da->size = 0;                                                  \
+  }                                                                 \
+  /* Frees data of array, which was prepared by "init_in_place".    \
+     Array stays valid and empty. */                                \
+  NEDA_API void neda_##_postfix##__destroy(                         \
+      struct neda_##_postfix *_da)                                  \
+  {                                                                 \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                               \
+    neda_deallocate(_da->allocator, _da->data);                     \
+    _da->data = 0;                                                  \
+    _da->capacity = 0;                                              \
+    _da->size = 0;                                                  \
   }                                                                 \
   NEDA_API void neda_##_postfix##__free(                            \
       struct neda_##_postfix **_da)                                 \
   {                                                                 \
     NEDA_ASSERT((void *)(*_da));                                    \
-    NEDA_FREE((*_da)->data);                                        \
-    NEDA_FREE(*_da);                                                \
+    neda_deallocate((*_da)->allocator, (*_da)->data);               \
+    neda_deallocate((*_da)->allocator, *_da);                       \
     *_da = 0;                                                       \
   }
 
+#define NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(_postfix, _type, _chunk_size, _growth_policy) \
+  NEDA_BODY_IMPLEMENTATION__GENERIC(                                                          \
+      _postfix,                                                                               \
+      _type,                                                                                  \
+      _chunk_size,                                                                            \
+      _growth_policy,                                                                         \
+      _functions->compare(_a, _b) > 0,                                                        \
+      1)
+
+/* Comparison "_less_expression" of "_a" and "_b" pointers is built into
+ * generated sort functions, so it can be inlined. Compare function is
+ * not used by them. Functions table of array is available in expression
+ * as "_functions". Example:
+ *   NEDA_BODY_IMPLEMENTATION_CMP(int, 128, *_a < *_b)
+ */
+#define NEDA_BODY_IMPLEMENTATION_CMP_POSTFIX(_postfix, _type, _chunk_size, _less_expression) \
+  NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(                                               \
+      _postfix,                                                                              \
+      _type,                                                                                 \
+      _chunk_size,                                                                           \
+      NEDA_GROWTH_CHUNK,                                                                     \
+      _less_expression)
+
+#define NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(_postfix, _type, _chunk_size, _growth_policy, _less_expression) \
+  NEDA_BODY_IMPLEMENTATION__GENERIC(                                                                                \
+      _postfix,                                                                                                     \
+      _type,                                                                                                        \
+      _chunk_size,                                                                                                  \
+      _growth_policy,                                                                                               \
+      _less_expression,                                                                                             \
+      0)
+
+#define NEDA_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type, _chunk_size) \
+  NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(_postfix, _type, _chunk_size, NEDA_GROWTH_CHUNK)
+
 #define NEDA_BODY_IMPLEMENTATION(_type, _chunk_size) NEDA_BODY_IMPLEMENTATION_POSTFIX(_type, _type, _chunk_size)
+#define NEDA_BODY_IMPLEMENTATION_GROWTH(_type, _chunk_size, _growth_policy) \
+  NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(_type, _type, _chunk_size, _growth_policy)
+#define NEDA_BODY_IMPLEMENTATION_CMP(_type, _chunk_size, _less_expression) \
+  NEDA_BODY_IMPLEMENTATION_CMP_POSTFIX(_type, _type, _chunk_size, _less_expression)
+#define NEDA_BODY_IMPLEMENTATION_CMP_GROWTH(_type, _chunk_size, _growth_policy, _less_expression) \
+  NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(_type, _type, _chunk_size, _growth_policy, _less_expression)
 #define NEDA_HEADER(_type) NEDA_HEADER_POSTFIX(_type, _type)
 
+
+/* Kinds of keys for radix sort. */
+#define NEDA_RADIX_UNSIGNED 0
+#define NEDA_RADIX_SIGNED 1
+#define NEDA_RADIX_FLOAT 2
+
+/* LSD radix sort for integer (8, 16, 32 and 64-bit) and IEEE float
+ * element types. "_kind" is one of NEDA_RADIX_UNSIGNED, NEDA_RADIX_SIGNED
+ * and NEDA_RADIX_FLOAT. It needs scratch buffer of the same size as
+ * array, but does not call compare function at all. Digits, which are
+ * the same for all keys, are skipped. Example:
+ *   NEDA_HEADER(int)
+ *   NEDA_BODY_IMPLEMENTATION(int, 128)
+ *   NEDA_RADIX_HEADER(int)
+ *   NEDA_RADIX_BODY_IMPLEMENTATION(int, NEDA_RADIX_SIGNED)
+ *
+ * "radix_sort_by_<_name>" is stable sort of any elements by integer
+ * key, which "_key_expression" gets from "_element" pointer. Example:
+ *   NEDA_RADIX_KEY_HEADER_POSTFIX(event, struct event, time)
+ *   NEDA_RADIX_KEY_BODY_IMPLEMENTATION_POSTFIX(
+ *       event, struct event, time,
+ *       unsigned int, NEDA_RADIX_UNSIGNED, _element->time)
+ */
+#define NEDA_RADIX_ENGINE(_name, _type, _key_type, _kind, _key_expression) \
+  /* \returns byte of key with "_pass" significance (0 is the least        \
+     significant byte), already transformed for unsigned ordering. */      \
+  NEDA_INTERNAL unsigned int _name##_digit(                                \
+      const _type *_element,                                               \
+      const unsigned int _pass)                                            \
+  {                                                                        \
+    const _key_type key = (_key_expression);                               \
+    const unsigned int endianness_test = 1;                                \
+    const int little_endian = *(const unsigned char *)&endianness_test;    \
+    const unsigned char *bytes = (const unsigned char *)&key;              \
+    NEDA_REGISTER unsigned int digit;                                      \
+    NEDA_REGISTER unsigned int top;                                        \
+    digit = bytes[little_endian ? _pass : sizeof(_key_type) - 1 - _pass];  \
+    top = bytes[little_endian ? sizeof(_key_type) - 1 : 0];                \
+    switch (_kind)                                                         \
+    {                                                                      \
+    case NEDA_RADIX_SIGNED:                                                \
+      if (_pass == sizeof(_key_type) - 1)                                  \
+      {                                                                    \
+        digit ^= 0x80U;                                                    \
+      }                                                                    \
+      break;                                                               \
+    case NEDA_RADIX_FLOAT:                                                 \
+      if (top & 0x80U)                                                     \
+      {                                                                    \
+        digit = ~digit & 0xFFU;                                            \
+      }                                                                    \
+      else if (_pass == sizeof(_key_type) - 1)                             \
+      {                                                                    \
+        digit ^= 0x80U;                                                    \
+      }                                                                    \
+      break;                                                               \
+    default:                                                               \
+      break;                                                               \
+    }                                                                      \
+    return digit;                                                          \
+  }                                                                        \
+  /* Stable LSD radix sort with 8-bit digits. "_scratch" should have       \
+     place for "_size" elements. */                                        \
+  NEDA_INTERNAL void _name(                                                \
+      _type *_data,                                                        \
+      const nedasize_t _size,                                              \
+      _type *_scratch)                                                     \
+  {                                                                        \
+    nedasize_t counts[sizeof(_key_type)][256];                             \
+    NEDA_REGISTER nedasize_t i;                                            \
+    NEDA_REGISTER unsigned int pass;                                       \
+    nedasize_t offset, count;                                              \
+    _type *source = _data;                                                 \
+    _type *destination = _scratch;                                         \
+    _type *temp;                                                           \
+    memset(counts, 0, sizeof(counts));                                     \
+    i = 0;                                                                 \
+    while (i < _size)                                                      \
+    {                                                                      \
+      pass = 0;                                                            \
+      while (pass < sizeof(_key_type))                                     \
+      {                                                                    \
+        counts[pass][_name##_digit(&_data[i], pass)]++;                    \
+        pass++;                                                            \
+      }                                                                    \
+      i++;                                                                 \
+    }                                                                      \
+    pass = 0;                                                              \
+    while (pass < sizeof(_key_type))                                       \
+    {                                                                      \
+      /* All elements have the same digit - nothing to do. */              \
+      if (counts[pass][_name##_digit(&source[0], pass)] == _size)          \
+      {                                                                    \
+        pass++;                                                            \
+        continue;                                                          \
+      }                                                                    \
+      offset = 0;                                                          \
+      i = 0;                                                               \
+      while (i < 256)                                                      \
+      {                                                                    \
+        count = counts[pass][i];                                           \
+        counts[pass][i] = offset;                                          \
+        offset += count;                                                   \
+        i++;                                                               \
+      }                                                                    \
+      i = 0;                                                               \
+      while (i < _size)                                                    \
+      {                                                                    \
+        destination[counts[pass][_name##_digit(&source[i], pass)]++] =     \
+            source[i];                                                     \
+        i++;                                                               \
+      }                                                                    \
+      temp = source;                                                       \
+      source = destination;                                                \
+      destination = temp;                                                  \
+      pass++;                                                              \
+    }                                                                      \
+    if (source != _data)                                                   \
+    {                                                                      \
+      memcpy(_data, source, sizeof(_type) * _size);                        \
+    }                                                                      \
+  }
+
+#define NEDA_RADIX_HEADER_POSTFIX(_postfix, _type) \
+  NEDA_DEF void neda_##_postfix##__radix_sort(struct neda_##_postfix *_da);
+
+#define NEDA_RADIX_KEY_HEADER_POSTFIX(_postfix, _type, _name) \
+  NEDA_DEF void neda_##_postfix##__radix_sort_by_##_name(struct neda_##_postfix *_da);
+
+#define NEDA_RADIX_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type, _kind) \
+  NEDA_RADIX_ENGINE(                                                   \
+      neda_##_postfix##__radix_engine,                                 \
+      _type,                                                           \
+      _type,                                                           \
+      _kind,                                                           \
+      *_element)                                                       \
+  NEDA_API void neda_##_postfix##__radix_sort(                         \
+      struct neda_##_postfix *_da)                                     \
+  {                                                                    \
+    _type *scratch;                                                    \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                  \
+    if (_da->size < 2)                                                 \
+    {                                                                  \
+      return;                                                          \
+    }                                                                  \
+    scratch = (_type *)neda_allocate(                                  \
+        _da->allocator,                                                \
+        sizeof(_type) * _da->size);                                    \
+    NEDA_ASSERT(scratch);                                              \
+    neda_##_postfix##__radix_engine(                                   \
+        _da->data,                                                     \
+        _da->size,                                                     \
+        scratch);                                                      \
+    neda_deallocate(_da->allocator, scratch);                          \
+  }
+
+#define NEDA_RADIX_KEY_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type, _name, _key_type, _kind, _key_expression) \
+  NEDA_RADIX_ENGINE(                                                                                          \
+      neda_##_postfix##__radix_engine_by_##_name,                                                             \
+      _type,                                                                                                  \
+      _key_type,                                                                                              \
+      _kind,                                                                                                  \
+      _key_expression)                                                                                        \
+  NEDA_API void neda_##_postfix##__radix_sort_by_##_name(                                                     \
+      struct neda_##_postfix *_da)                                                                            \
+  {                                                                                                           \
+    _type *scratch;                                                                                           \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                                                         \
+    if (_da->size < 2)                                                                                        \
+    {                                                                                                         \
+      return;                                                                                                 \
+    }                                                                                                         \
+    scratch = (_type *)neda_allocate(                                                                         \
+        _da->allocator,                                                                                       \
+        sizeof(_type) * _da->size);                                                                           \
+    NEDA_ASSERT(scratch);                                                                                     \
+    neda_##_postfix##__radix_engine_by_##_name(                                                               \
+        _da->data,                                                                                            \
+        _da->size,                                                                                            \
+        scratch);                                                                                             \
+    neda_deallocate(_da->allocator, scratch);                                                                 \
+  }
+
+#define NEDA_RADIX_HEADER(_type) NEDA_RADIX_HEADER_POSTFIX(_type, _type)
+#define NEDA_RADIX_BODY_IMPLEMENTATION(_type, _kind) NEDA_RADIX_BODY_IMPLEMENTATION_POSTFIX(_type, _type, _kind)
+#define NEDA_RADIX_KEY_HEADER(_type, _name) NEDA_RADIX_KEY_HEADER_POSTFIX(_type, _type, _name)
+#define NEDA_RADIX_KEY_BODY_IMPLEMENTATION(_type, _name, _key_type, _kind, _key_expression) \
+  NEDA_RADIX_KEY_BODY_IMPLEMENTATION_POSTFIX(_type, _type, _name, _key_type, _kind, _key_expression)
+
+
+/* Elements, which "find" checks at once before exit. */
+#ifndef NEDA_NUMERIC_BLOCK
+#define NEDA_NUMERIC_BLOCK 32
+#endif
+
+/* Independent accumulators of "sum", "min" and "max". */
+#ifndef NEDA_NUMERIC_LANES
+#define NEDA_NUMERIC_LANES 16
+#endif
+
+/* If NEDA_SIMD is defined, numeric kernels are compiled for AVX2 and
+ * for base instruction set, and version is selected at runtime by CPU
+ * (GCC and clang on x86, others use base version only).
+ */
+#if defined(NEDA_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NEDA_SIMD_DISPATCH __attribute__((target_clones("avx2", "default")))
+#else
+#define NEDA_SIMD_DISPATCH
+#endif
+
+/* Functions for arrays of numbers: "find", "count", "sum", "min" and
+ * "max". "_sum_type" is type of "sum" result, so it can be wider than
+ * "_type". Kernels are written as loops without early exit and with
+ * independent accumulators, so compiler turns them into SSE2 or AVX2
+ * code. Order of "sum" of floating point numbers differs from
+ * sequential sum, result of "min" and "max" is unspecified, if array
+ * has NaN. Example:
+ *   NEDA_NUMERIC_HEADER(int, long)
+ *   NEDA_NUMERIC_BODY_IMPLEMENTATION(int, long)
+ */
+#define NEDA_NUMERIC_HEADER_POSTFIX(_postfix, _type, _sum_type)                                  \
+  NEDA_DEF nedasize_t neda_##_postfix##__find(struct neda_##_postfix *_da, const _type _value);  \
+  NEDA_DEF nedasize_t neda_##_postfix##__count(struct neda_##_postfix *_da, const _type _value); \
+  NEDA_DEF _sum_type neda_##_postfix##__sum(struct neda_##_postfix *_da);                        \
+  NEDA_DEF _type neda_##_postfix##__min(struct neda_##_postfix *_da);                            \
+  NEDA_DEF _type neda_##_postfix##__max(struct neda_##_postfix *_da);                            \
+  NEDA_DEF double neda_##_postfix##__percentile(struct neda_##_postfix *_da, const double _percent);
+
+#define NEDA_NUMERIC_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type, _sum_type) \
+  NEDA_INTERNAL NEDA_SIMD_DISPATCH nedasize_t                                \
+      neda_##_postfix##__find_kernel(                                        \
+      const _type *_data,                                                    \
+      const nedasize_t _size,                                                \
+      const _type _value)                                                    \
+  {                                                                          \
+    NEDA_REGISTER nedasize_t i = 0;                                          \
+    NEDA_REGISTER nedasize_t j;                                              \
+    int found;                                                               \
+    /* Whole blocks are checked without early exit, so the check is          \
+       vectorized, and only the block with match is scanned again. */        \
+    while (i + NEDA_NUMERIC_BLOCK <= _size)                                  \
+    {                                                                        \
+      found = 0;                                                             \
+      j = 0;                                                                 \
+      while (j < NEDA_NUMERIC_BLOCK)                                         \
+      {                                                                      \
+        found |= _data[i + j] == _value;                                     \
+        j++;                                                                 \
+      }                                                                      \
+      if (found)                                                             \
+      {                                                                      \
+        break;                                                               \
+      }                                                                      \
+      i += NEDA_NUMERIC_BLOCK;                                               \
+    }                                                                        \
+    while (i < _size && !(_data[i] == _value))                               \
+    {                                                                        \
+      i++;                                                                   \
+    }                                                                        \
+    return i;                                                                \
+  }                                                                          \
+  NEDA_INTERNAL NEDA_SIMD_DISPATCH nedasize_t                                \
+      neda_##_postfix##__count_kernel(                                       \
+      const _type *_data,                                                    \
+      const nedasize_t _size,                                                \
+      const _type _value)                                                    \
+  {                                                                          \
+    NEDA_REGISTER nedasize_t i = 0;                                          \
+    nedasize_t count = 0;                                                    \
+    while (i < _size)                                                        \
+    {                                                                        \
+      count += _data[i] == _value;                                           \
+      i++;                                                                   \
+    }                                                                        \
+    return count;                                                            \
+  }                                                                          \
+  /* Every lane has it's own accumulator, so compiler can keep them          \
+     in one vector register without reordering of operations. */             \
+  NEDA_INTERNAL NEDA_SIMD_DISPATCH _sum_type                                 \
+      neda_##_postfix##__sum_kernel(                                         \
+      const _type *_data,                                                    \
+      const nedasize_t _size)                                                \
+  {                                                                          \
+    _sum_type sums[NEDA_NUMERIC_LANES];                                      \
+    _sum_type sum = 0;                                                       \
+    NEDA_REGISTER nedasize_t i = 0;                                          \
+    NEDA_REGISTER nedasize_t j;                                              \
+    j = 0;                                                                   \
+    while (j < NEDA_NUMERIC_LANES)                                           \
+    {                                                                        \
+      sums[j] = 0;                                                           \
+      j++;                                                                   \
+    }                                                                        \
+    while (i + NEDA_NUMERIC_LANES <= _size)                                  \
+    {                                                                        \
+      j = 0;                                                                 \
+      while (j < NEDA_NUMERIC_LANES)                                         \
+      {                                                                      \
+        sums[j] += _data[i + j];                                             \
+        j++;                                                                 \
+      }                                                                      \
+      i += NEDA_NUMERIC_LANES;                                               \
+    }                                                                        \
+    j = 0;                                                                   \
+    while (j < NEDA_NUMERIC_LANES)                                           \
+    {                                                                        \
+      sum += sums[j];                                                        \
+      j++;                                                                   \
+    }                                                                        \
+    while (i < _size)                                                        \
+    {                                                                        \
+      sum += _data[i];                                                       \
+      i++;                                                                   \
+    }                                                                        \
+    return sum;                                                              \
+  }                                                                          \
+  /* \returns value of the least ("_greater" is 0) or the greatest           \
+     element. "_size" should not be 0. */                                    \
+  NEDA_INTERNAL NEDA_SIMD_DISPATCH _type                                     \
+      neda_##_postfix##__extremum_kernel(                                    \
+      const _type *_data,                                                    \
+      const nedasize_t _size,                                                \
+      const int _greater)                                                    \
+  {                                                                          \
+    _type lanes[NEDA_NUMERIC_LANES];                                         \
+    _type result = _data[0];                                                 \
+    NEDA_REGISTER nedasize_t i = 0;                                          \
+    NEDA_REGISTER nedasize_t j;                                              \
+    j = 0;                                                                   \
+    while (j < NEDA_NUMERIC_LANES)                                           \
+    {                                                                        \
+      lanes[j] = _data[0];                                                   \
+      j++;                                                                   \
+    }                                                                        \
+    while (i + NEDA_NUMERIC_LANES <= _size)                                  \
+    {                                                                        \
+      j = 0;                                                                 \
+      if (_greater)                                                          \
+      {                                                                      \
+        while (j < NEDA_NUMERIC_LANES)                                       \
+        {                                                                    \
+          lanes[j] = _data[i + j] > lanes[j] ? _data[i + j] : lanes[j];      \
+          j++;                                                               \
+        }                                                                    \
+      }                                                                      \
+      else                                                                   \
+      {                                                                      \
+        while (j < NEDA_NUMERIC_LANES)                                       \
+        {                                                                    \
+          lanes[j] = _data[i + j] < lanes[j] ? _data[i + j] : lanes[j];      \
+          j++;                                                               \
+        }                                                                    \
+      }                                                                      \
+      i += NEDA_NUMERIC_LANES;                                               \
+    }                                                                        \
+    while (i < _size)                                                        \
+    {                                                                        \
+      lanes[0] = (_greater ? _data[i] > lanes[0] : _data[i] < lanes[0])      \
+                     ? _data[i]                                              \
+                     : lanes[0];                                             \
+      i++;                                                                   \
+    }                                                                        \
+    j = 0;                                                                   \
+    while (j < NEDA_NUMERIC_LANES)                                           \
+    {                                                                        \
+      result = (_greater ? lanes[j] > result : lanes[j] < result)            \
+                   ? lanes[j]                                                \
+                   : result;                                                 \
+      j++;                                                                   \
+    }                                                                        \
+    return result;                                                           \
+  }                                                                          \
+  /* \returns index of first element equal to "_value" or size of            \
+     array, if there is no such element. */                                  \
+  NEDA_API nedasize_t neda_##_postfix##__find(                               \
+      struct neda_##_postfix *_da,                                           \
+      const _type _value)                                                    \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    return neda_##_postfix##__find_kernel(_da->data, _da->size, _value);     \
+  }                                                                          \
+  NEDA_API nedasize_t neda_##_postfix##__count(                              \
+      struct neda_##_postfix *_da,                                           \
+      const _type _value)                                                    \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    return neda_##_postfix##__count_kernel(_da->data, _da->size, _value);    \
+  }                                                                          \
+  NEDA_API _sum_type neda_##_postfix##__sum(                                 \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    return neda_##_postfix##__sum_kernel(_da->data, _da->size);              \
+  }                                                                          \
+  NEDA_API _type neda_##_postfix##__min(                                     \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    NEDA_ASSERT(_da->size);                                                  \
+    return neda_##_postfix##__extremum_kernel(_da->data, _da->size, 0);      \
+  }                                                                          \
+  NEDA_API _type neda_##_postfix##__max(                                     \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    NEDA_ASSERT(_da->size);                                                  \
+    return neda_##_postfix##__extremum_kernel(_da->data, _da->size, 1);      \
+  }                                                                          \
+  NEDA_INTERNAL int neda_##_postfix##__numeric_less(                         \
+      const void *_context,                                                  \
+      const _type *_a,                                                       \
+      const _type *_b)                                                       \
+  {                                                                          \
+    NEDA_UNUSED(_context);                                                   \
+    return *_a < *_b;                                                        \
+  }                                                                          \
+  NEDA_SORT_ENGINE(                                                          \
+      neda_##_postfix##__numeric_engine,                                     \
+      _type,                                                                 \
+      void,                                                                  \
+      neda_##_postfix##__numeric_less)                                       \
+  /* \returns "_percent" percentile (from 0 to 100) with linear              \
+     interpolation between closest ranks, so 50 gives median. Array          \
+     is reordered like by "nth_element" in O(n), it should not be            \
+     empty. */                                                               \
+  NEDA_API double neda_##_postfix##__percentile(                             \
+      struct neda_##_postfix *_da,                                           \
+      const double _percent)                                                 \
+  {                                                                          \
+    double rank, low_value, high_value;                                      \
+    nedasize_t low;                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    NEDA_ASSERT(_da->size);                                                  \
+    NEDA_ASSERT(_percent >= 0.0 && _percent <= 100.0);                       \
+    rank = _percent / 100.0 * (double)(_da->size - 1);                       \
+    low = (nedasize_t)rank;                                                  \
+    neda_##_postfix##__numeric_engine_select(                                \
+        _da->data,                                                           \
+        _da->data + low,                                                     \
+        _da->data + _da->size,                                               \
+        0);                                                                  \
+    low_value = (double)_da->data[low];                                      \
+    if (low + 1 >= _da->size)                                                \
+    {                                                                        \
+      return low_value;                                                      \
+    }                                                                        \
+    /* Next rank is the least element after "low". */                        \
+    high_value = (double)neda_##_postfix##__extremum_kernel(                 \
+        _da->data + low + 1,                                                 \
+        _da->size - low - 1,                                                 \
+        0);                                                                  \
+    return low_value + (high_value - low_value) * (rank - (double)low);      \
+  }
+
+#define NEDA_NUMERIC_HEADER(_type, _sum_type) NEDA_NUMERIC_HEADER_POSTFIX(_type, _type, _sum_type)
+#define NEDA_NUMERIC_BODY_IMPLEMENTATION(_type, _sum_type) NEDA_NUMERIC_BODY_IMPLEMENTATION_POSTFIX(_type, _type, _sum_type)
+
+
+/* Smallest capacity of deque buffer. Should be power of two. */
+#ifndef NEDA_DEQUE_MIN_CAPACITY
+#define NEDA_DEQUE_MIN_CAPACITY 16
+#endif
+
+/* Double-ended queue on ring buffer. Capacity is always power of two,
+ * so index is wrapped by mask and "push_front", "pop_front",
+ * "push_back" and "pop_back" are O(1). Elements are kept in at most two
+ * contiguous spans ("spans"), which are used for bulk copies. Functions
+ * have the same names as neda ones with "neda_deque_" prefix. Example:
+ *   NEDA_DEQUE_HEADER(int)
+ *   NEDA_DEQUE_BODY_IMPLEMENTATION(int)
+ *   ...
+ *   struct neda_deque_int *dq;
+ *   neda_deque_int__init(&dq);
+ *   neda_deque_int__push_front(dq, 1);
+ */
+#define NEDA_DEQUE_HEADER_POSTFIX(_postfix, _type)                                                             \
+  typedef struct neda_deque_##_postfix                                                                         \
+  {                                                                                                            \
+    _type *data;                                                                                               \
+    nedasize_t capacity, size, head;                                                                           \
+  } neda_deque_##_postfix;                                                                                     \
+  NEDA_DEF void neda_deque_##_postfix##__init(struct neda_deque_##_postfix **_dq);                             \
+  NEDA_DEF void neda_deque_##_postfix##__reserve(struct neda_deque_##_postfix *_dq, const nedasize_t _size);   \
+  NEDA_DEF nedasize_t neda_deque_##_postfix##__size(struct neda_deque_##_postfix *_dq);                        \
+  NEDA_DEF nedasize_t neda_deque_##_postfix##__capacity(struct neda_deque_##_postfix *_dq);                    \
+  NEDA_DEF void neda_deque_##_postfix##__push_back(struct neda_deque_##_postfix *_dq, const _type _value);     \
+  NEDA_DEF _type neda_deque_##_postfix##__pop_back(struct neda_deque_##_postfix *_dq);                         \
+  NEDA_DEF void neda_deque_##_postfix##__push_front(struct neda_deque_##_postfix *_dq, const _type _value);    \
+  NEDA_DEF _type neda_deque_##_postfix##__pop_front(struct neda_deque_##_postfix *_dq);                        \
+  NEDA_DEF _type neda_deque_##_postfix##__front(struct neda_deque_##_postfix *_dq);                            \
+  NEDA_DEF _type neda_deque_##_postfix##__back(struct neda_deque_##_postfix *_dq);                             \
+  NEDA_DEF _type neda_deque_##_postfix##__at(struct neda_deque_##_postfix *_dq, const nedasize_t _index);      \
+  NEDA_DEF _type *neda_deque_##_postfix##__at_ptr(struct neda_deque_##_postfix *_dq, const nedasize_t _index); \
+  NEDA_DEF void neda_deque_##_postfix##__append_n(                                                             \
+      struct neda_deque_##_postfix *_dq, const _type *_values, const nedasize_t _count);                       \
+  NEDA_DEF void neda_deque_##_postfix##__spans(                                                                \
+      struct neda_deque_##_postfix *_dq,                                                                       \
+      _type **_first, nedasize_t *_first_size,                                                                 \
+      _type **_second, nedasize_t *_second_size);                                                              \
+  NEDA_DEF void neda_deque_##_postfix##__copy_to(struct neda_deque_##_postfix *_dq, _type *_destination);      \
+  NEDA_DEF void neda_deque_##_postfix##__clear(struct neda_deque_##_postfix *_dq);                             \
+  NEDA_DEF void neda_deque_##_postfix##__free(struct neda_deque_##_postfix **_dq);
+
+#define NEDA_DEQUE_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)          \
+  NEDA_API void neda_deque_##_postfix##__init(                           \
+      struct neda_deque_##_postfix **_dq)                                \
+  {                                                                      \
+    *_dq = (struct neda_deque_##_postfix *)NEDA_MALLOC(                  \
+        sizeof(struct neda_deque_##_postfix));                           \
+    NEDA_ASSERT(*_dq);                                                   \
+    (*_dq)->data = 0;                                                    \
+    (*_dq)->capacity = 0;                                                \
+    (*_dq)->size = 0;                                                    \
+    (*_dq)->head = 0;                                                    \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__reserve(                        \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const nedasize_t _size)                                            \
+  {                                                                      \
+    NEDA_REGISTER nedasize_t new_capacity;                               \
+    nedasize_t wrapped;                                                  \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    if (_size <= _dq->capacity)                                          \
+    {                                                                    \
+      return;                                                            \
+    }                                                                    \
+    new_capacity = _dq->capacity ? _dq->capacity                         \
+                                 : NEDA_DEQUE_MIN_CAPACITY;              \
+    while (new_capacity < _size)                                         \
+    {                                                                    \
+      /* Doubling would wrap to zero and never reach "_size". */         \
+      if (new_capacity > (nedasize_t)-1 / 2)                             \
+      {                                                                  \
+        NEDA_ASSERT(0);                                                  \
+        return;                                                          \
+      }                                                                  \
+      new_capacity <<= 1;                                                \
+    }                                                                    \
+    /* Byte count can overflow only when nedasize_t is size_t. */        \
+    if (sizeof(_type) * new_capacity / sizeof(_type) != new_capacity)    \
+    {                                                                    \
+      NEDA_ASSERT(0);                                                    \
+      return;                                                            \
+    }                                                                    \
+    _dq->data = (_type *)NEDA_REALLOC(                                   \
+        _dq->data,                                                       \
+        sizeof(_type) * new_capacity);                                   \
+    NEDA_ASSERT(_dq->data);                                              \
+    /* Wrapped part is placed after old end. New capacity is at least    \
+       twice bigger, so there is enough place for it. */                 \
+    if (_dq->head + _dq->size > _dq->capacity)                           \
+    {                                                                    \
+      wrapped = _dq->head + _dq->size - _dq->capacity;                   \
+      memcpy(                                                            \
+          _dq->data + _dq->capacity,                                     \
+          _dq->data,                                                     \
+          sizeof(_type) * wrapped);                                      \
+    }                                                                    \
+    _dq->capacity = new_capacity;                                        \
+  }                                                                      \
+  NEDA_API nedasize_t neda_deque_##_postfix##__size(                     \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(_dq);                                                    \
+    return _dq->size;                                                    \
+  }                                                                      \
+  NEDA_API nedasize_t neda_deque_##_postfix##__capacity(                 \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(_dq);                                                    \
+    return _dq->capacity;                                                \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__push_back(                      \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const _type _value)                                                \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    neda_deque_##_postfix##__reserve(                                    \
+        _dq,                                                             \
+        _dq->size + 1);                                                  \
+    _dq->data[(_dq->head + _dq->size) & (_dq->capacity - 1)] = _value;   \
+    _dq->size++;                                                         \
+  }                                                                      \
+  NEDA_API _type neda_deque_##_postfix##__pop_back(                      \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size);                                              \
+    _dq->size--;                                                         \
+    return _dq->data[(_dq->head + _dq->size) & (_dq->capacity - 1)];     \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__push_front(                     \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const _type _value)                                                \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    neda_deque_##_postfix##__reserve(                                    \
+        _dq,                                                             \
+        _dq->size + 1);                                                  \
+    _dq->head = (_dq->head - 1) & (_dq->capacity - 1);                   \
+    _dq->data[_dq->head] = _value;                                       \
+    _dq->size++;                                                         \
+  }                                                                      \
+  NEDA_API _type neda_deque_##_postfix##__pop_front(                     \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    _type result;                                                        \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size);                                              \
+    result = _dq->data[_dq->head];                                       \
+    _dq->head = (_dq->head + 1) & (_dq->capacity - 1);                   \
+    _dq->size--;                                                         \
+    return result;                                                       \
+  }                                                                      \
+  NEDA_API _type neda_deque_##_postfix##__front(                         \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size);                                              \
+    return _dq->data[_dq->head];                                         \
+  }                                                                      \
+  NEDA_API _type neda_deque_##_postfix##__back(                          \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size);                                              \
+    return _dq->data[(_dq->head + _dq->size - 1) & (_dq->capacity - 1)]; \
+  }                                                                      \
+  NEDA_API _type neda_deque_##_postfix##__at(                            \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const nedasize_t _index)                                           \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size > _index);                                     \
+    return _dq->data[(_dq->head + _index) & (_dq->capacity - 1)];        \
+  }                                                                      \
+  NEDA_API _type *neda_deque_##_postfix##__at_ptr(                       \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const nedasize_t _index)                                           \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_dq->size > _index);                                     \
+    return &_dq->data[(_dq->head + _index) & (_dq->capacity - 1)];       \
+  }                                                                      \
+  /* "_values" should not point into storage of "_dq", it can be         \
+     reallocated and wrapped. */                                         \
+  NEDA_API void neda_deque_##_postfix##__append_n(                       \
+      struct neda_deque_##_postfix *_dq,                                 \
+      const _type *_values,                                              \
+      const nedasize_t _count)                                           \
+  {                                                                      \
+    nedasize_t tail, first_count;                                        \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    NEDA_ASSERT(_values || !_count);                                     \
+    NEDA_ASSERT(!_dq->data ||                                            \
+                _values < _dq->data ||                                   \
+                _values >= _dq->data + _dq->capacity);                   \
+    if (!_count)                                                         \
+    {                                                                    \
+      return;                                                            \
+    }                                                                    \
+    neda_deque_##_postfix##__reserve(                                    \
+        _dq,                                                             \
+        _dq->size + _count);                                             \
+    tail = (_dq->head + _dq->size) & (_dq->capacity - 1);                \
+    first_count = _dq->capacity - tail;                                  \
+    if (first_count > _count)                                            \
+    {                                                                    \
+      first_count = _count;                                              \
+    }                                                                    \
+    memcpy(_dq->data + tail, _values, sizeof(_type) * first_count);      \
+    memcpy(                                                              \
+        _dq->data,                                                       \
+        _values + first_count,                                           \
+        sizeof(_type) * (_count - first_count));                         \
+    _dq->size += _count;                                                 \
+  }                                                                      \
+  /* Elements are stored in two contiguous spans: "_first" is front      \
+     part, "_second" is wrapped part at the beginning of buffer. */      \
+  NEDA_API void neda_deque_##_postfix##__spans(                          \
+      struct neda_deque_##_postfix *_dq,                                 \
+      _type **_first,                                                    \
+      nedasize_t *_first_size,                                           \
+      _type **_second,                                                   \
+      nedasize_t *_second_size)                                          \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    *_first = _dq->data + _dq->head;                                     \
+    *_first_size = _dq->size;                                            \
+    *_second = _dq->data;                                                \
+    *_second_size = 0;                                                   \
+    if (_dq->head + _dq->size > _dq->capacity)                           \
+    {                                                                    \
+      *_first_size = _dq->capacity - _dq->head;                          \
+      *_second_size = _dq->size - *_first_size;                          \
+    }                                                                    \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__copy_to(                        \
+      struct neda_deque_##_postfix *_dq,                                 \
+      _type *_destination)                                               \
+  {                                                                      \
+    _type *first, *second;                                               \
+    nedasize_t first_size, second_size;                                  \
+    neda_deque_##_postfix##__spans(                                      \
+        _dq,                                                             \
+        &first,                                                          \
+        &first_size,                                                     \
+        &second,                                                         \
+        &second_size);                                                   \
+    if (first_size)                                                      \
+    {                                                                    \
+      memcpy(_destination, first, sizeof(_type) * first_size);           \
+    }                                                                    \
+    if (second_size)                                                     \
+    {                                                                    \
+      memcpy(                                                            \
+          _destination + first_size,                                     \
+          second,                                                        \
+          sizeof(_type) * second_size);                                  \
+    }                                                                    \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__clear(                          \
+      struct neda_deque_##_postfix *_dq)                                 \
+  {                                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_dq));                                    \
+    _dq->size = 0;                                                       \
+    _dq->head = 0;                                                       \
+  }                                                                      \
+  NEDA_API void neda_deque_##_postfix##__free(                           \
+      struct neda_deque_##_postfix **_dq)                                \
+  {                                                                      \
+    NEDA_ASSERT((void *)(*_dq));                                         \
+    NEDA_FREE((*_dq)->data);                                             \
+    NEDA_FREE(*_dq);                                                     \
+    *_dq = 0;                                                            \
+  }
+
+#define NEDA_DEQUE_HEADER(_type) NEDA_DEQUE_HEADER_POSTFIX(_type, _type)
+#define NEDA_DEQUE_BODY_IMPLEMENTATION(_type) NEDA_DEQUE_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+
+
+/* \returns logical false, if small array is valid. */
+#define NEDA_SMALL_VALIDATE(_da_ptr) (!_da_ptr || _da_ptr->size > _da_ptr->capacity)
+
+/* Array with small buffer optimization. Up to "_inline_capacity"
+ * elements are stored inside of struct, and only bigger arrays get heap
+ * memory, so array of few elements does not allocate at all. Struct is
+ * owned by caller (it can be on stack or inside of other struct), it
+ * is prepared by "init" and released by "destroy". Inline storage and
+ * heap pointer share memory, so struct can be copied by value, while
+ * it is inline. Example:
+ *   NEDA_SMALL_HEADER(int, 8)
+ *   NEDA_SMALL_BODY_IMPLEMENTATION(int)
+ *   ...
+ *   struct neda_small_int list;
+ *   neda_small_int__init(&list);
+ *   neda_small_int__push_back(&list, 1);
+ *   neda_small_int__destroy(&list);
+ */
+#define NEDA_SMALL_HEADER_POSTFIX(_postfix, _type, _inline_capacity)                                           \
+  enum                                                                                                         \
+  {                                                                                                            \
+    NEDA_SMALL_CAPACITY_##_postfix = _inline_capacity                                                          \
+  };                                                                                                           \
+  typedef struct neda_small_##_postfix                                                                         \
+  {                                                                                                            \
+    nedasize_t capacity, size;                                                                                 \
+    union                                                                                                      \
+    {                                                                                                          \
+      _type *heap;                                                                                             \
+      _type local[_inline_capacity];                                                                           \
+    } storage;                                                                                                 \
+  } neda_small_##_postfix;                                                                                     \
+  NEDA_DEF void neda_small_##_postfix##__init(struct neda_small_##_postfix *_da);                              \
+  NEDA_DEF void neda_small_##_postfix##__reserve(struct neda_small_##_postfix *_da, const nedasize_t _size);   \
+  NEDA_DEF nedasize_t neda_small_##_postfix##__size(struct neda_small_##_postfix *_da);                        \
+  NEDA_DEF _type *neda_small_##_postfix##__data(struct neda_small_##_postfix *_da);                            \
+  NEDA_DEF nedasize_t neda_small_##_postfix##__capacity(struct neda_small_##_postfix *_da);                    \
+  NEDA_DEF int neda_small_##_postfix##__is_inline(struct neda_small_##_postfix *_da);                          \
+  NEDA_DEF void neda_small_##_postfix##__push_back(struct neda_small_##_postfix *_da, const _type _value);     \
+  NEDA_DEF _type neda_small_##_postfix##__pop_back(struct neda_small_##_postfix *_da);                         \
+  NEDA_DEF _type neda_small_##_postfix##__at(struct neda_small_##_postfix *_da, const nedasize_t _index);      \
+  NEDA_DEF _type *neda_small_##_postfix##__at_ptr(struct neda_small_##_postfix *_da, const nedasize_t _index); \
+  NEDA_DEF void neda_small_##_postfix##__insert(                                                               \
+      struct neda_small_##_postfix *_da, const nedasize_t _index, const _type _value);                         \
+  NEDA_DEF void neda_small_##_postfix##__erase(struct neda_small_##_postfix *_da, const nedasize_t _index);    \
+  NEDA_DEF void neda_small_##_postfix##__append_n(                                                             \
+      struct neda_small_##_postfix *_da, const _type *_values, const nedasize_t _count);                       \
+  NEDA_DEF void neda_small_##_postfix##__clear(struct neda_small_##_postfix *_da);                             \
+  NEDA_DEF void neda_small_##_postfix##__destroy(struct neda_small_##_postfix *_da);
+
+#define NEDA_SMALL_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)       \
+  NEDA_API void neda_small_##_postfix##__init(                        \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    _da->capacity = NEDA_SMALL_CAPACITY_##_postfix;                   \
+    _da->size = 0;                                                    \
+  }                                                                   \
+  NEDA_API _type *neda_small_##_postfix##__data(                      \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    return _da->capacity > NEDA_SMALL_CAPACITY_##_postfix             \
+               ? _da->storage.heap                                    \
+               : _da->storage.local;                                  \
+  }                                                                   \
+  NEDA_API void neda_small_##_postfix##__reserve(                     \
+      struct neda_small_##_postfix *_da,                              \
+      const nedasize_t _size)                                         \
+  {                                                                   \
+    NEDA_REGISTER nedasize_t new_capacity;                            \
+    _type *heap;                                                      \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    if (_size <= _da->capacity)                                       \
+    {                                                                 \
+      return;                                                         \
+    }                                                                 \
+    new_capacity = _da->capacity * 2;                                 \
+    if (new_capacity < _size)                                         \
+    {                                                                 \
+      new_capacity = _size;                                           \
+    }                                                                 \
+    if (_da->capacity > NEDA_SMALL_CAPACITY_##_postfix)               \
+    {                                                                 \
+      heap = (_type *)NEDA_REALLOC(                                   \
+          _da->storage.heap,                                          \
+          sizeof(_type) * new_capacity);                              \
+      NEDA_ASSERT(heap);                                              \
+    }                                                                 \
+    else                                                              \
+    {                                                                 \
+      /* Elements leave inline storage before it is overwritten by    \
+         heap pointer. */                                             \
+      heap = (_type *)NEDA_MALLOC(sizeof(_type) * new_capacity);      \
+      NEDA_ASSERT(heap);                                              \
+      memcpy(heap, _da->storage.local, sizeof(_type) * _da->size);    \
+    }                                                                 \
+    _da->storage.heap = heap;                                         \
+    _da->capacity = new_capacity;                                     \
+  }                                                                   \
+  NEDA_API nedasize_t neda_small_##_postfix##__size(                  \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    return _da->size;                                                 \
+  }                                                                   \
+  NEDA_API nedasize_t neda_small_##_postfix##__capacity(              \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    return _da->capacity;                                             \
+  }                                                                   \
+  NEDA_API int neda_small_##_postfix##__is_inline(                    \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    return _da->capacity <= NEDA_SMALL_CAPACITY_##_postfix;           \
+  }                                                                   \
+  NEDA_API void neda_small_##_postfix##__push_back(                   \
+      struct neda_small_##_postfix *_da,                              \
+      const _type _value)                                             \
+  {                                                                   \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    neda_small_##_postfix##__reserve(                                 \
+        _da,                                                          \
+        _da->size + 1);                                               \
+    neda_small_##_postfix##__data(_da)[_da->size] = _value;           \
+    _da->size++;                                                      \
+  }                                                                   \
+  NEDA_API _type neda_small_##_postfix##__pop_back(                   \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_da->size);                                           \
+    _da->size--;                                                      \
+    return neda_small_##_postfix##__data(_da)[_da->size];             \
+  }                                                                   \
+  NEDA_API _type neda_small_##_postfix##__at(                         \
+      struct neda_small_##_postfix *_da,                              \
+      const nedasize_t _index)                                        \
+  {                                                                   \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_da->size > _index);                                  \
+    return neda_small_##_postfix##__data(_da)[_index];                \
+  }                                                                   \
+  NEDA_API _type *neda_small_##_postfix##__at_ptr(                    \
+      struct neda_small_##_postfix *_da,                              \
+      const nedasize_t _index)                                        \
+  {                                                                   \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_da->size > _index);                                  \
+    return &neda_small_##_postfix##__data(_da)[_index];               \
+  }                                                                   \
+  NEDA_API void neda_small_##_postfix##__insert(                      \
+      struct neda_small_##_postfix *_da,                              \
+      const nedasize_t _index,                                        \
+      const _type _value)                                             \
+  {                                                                   \
+    _type *data;                                                      \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_da->size >= _index);                                 \
+    neda_small_##_postfix##__reserve(                                 \
+        _da,                                                          \
+        _da->size + 1);                                               \
+    data = neda_small_##_postfix##__data(_da);                        \
+    memmove(                                                          \
+        data + _index + 1,                                            \
+        data + _index,                                                \
+        sizeof(_type) * (_da->size - _index));                        \
+    data[_index] = _value;                                            \
+    _da->size++;                                                      \
+  }                                                                   \
+  NEDA_API void neda_small_##_postfix##__erase(                       \
+      struct neda_small_##_postfix *_da,                              \
+      const nedasize_t _index)                                        \
+  {                                                                   \
+    _type *data;                                                      \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_da->size > _index);                                  \
+    data = neda_small_##_postfix##__data(_da);                        \
+    memmove(                                                          \
+        data + _index,                                                \
+        data + _index + 1,                                            \
+        sizeof(_type) * (_da->size - _index - 1));                    \
+    _da->size--;                                                      \
+  }                                                                   \
+  /* "_values" may point to elements of "_da" itself, they are        \
+     read after reallocation from new storage. */                     \
+  NEDA_API void neda_small_##_postfix##__append_n(                    \
+      struct neda_small_##_postfix *_da,                              \
+      const _type *_values,                                           \
+      const nedasize_t _count)                                        \
+  {                                                                   \
+    const _type *data;                                                \
+    nedasize_t offset = 0;                                            \
+    int aliased;                                                      \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    NEDA_ASSERT(_values || !_count);                                  \
+    if (!_count)                                                      \
+    {                                                                 \
+      return;                                                         \
+    }                                                                 \
+    data = neda_small_##_postfix##__data(_da);                        \
+    aliased = _values >= data && _values < data + _da->capacity;      \
+    if (aliased)                                                      \
+    {                                                                 \
+      offset = (nedasize_t)(_values - data);                          \
+      NEDA_ASSERT(offset + _count <= _da->size);                      \
+    }                                                                 \
+    neda_small_##_postfix##__reserve(                                 \
+        _da,                                                          \
+        _da->size + _count);                                          \
+    if (aliased)                                                      \
+    {                                                                 \
+      _values = neda_small_##_postfix##__data(_da) + offset;          \
+    }                                                                 \
+    memcpy(                                                           \
+        neda_small_##_postfix##__data(_da) + _da->size,               \
+        _values,                                                      \
+        sizeof(_type) * _count);                                      \
+    _da->size += _count;                                              \
+  }                                                                   \
+  NEDA_API void neda_small_##_postfix##__clear(                       \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(!NEDA_SMALL_VALIDATE(_da));                           \
+    _da->size = 0;                                                    \
+  }                                                                   \
+  /* Frees heap storage, if array has spilled. Struct itself is owned \
+     by caller. */                                                    \
+  NEDA_API void neda_small_##_postfix##__destroy(                     \
+      struct neda_small_##_postfix *_da)                              \
+  {                                                                   \
+    NEDA_ASSERT(_da);                                                 \
+    if (_da->capacity > NEDA_SMALL_CAPACITY_##_postfix)               \
+    {                                                                 \
+      NEDA_FREE(_da->storage.heap);                                   \
+    }                                                                 \
+    _da->capacity = NEDA_SMALL_CAPACITY_##_postfix;                   \
+    _da->size = 0;                                                    \
+  }
+
+#define NEDA_SMALL_HEADER(_type, _inline_capacity) NEDA_SMALL_HEADER_POSTFIX(_type, _type, _inline_capacity)
+#define NEDA_SMALL_BODY_IMPLEMENTATION(_type) NEDA_SMALL_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+
+/* Binary snapshots of arrays: "save" writes "neda_snapshot_header"
+ * and data of array, "load" reads it back. With NEDA_MMAP snapshot
+ * can be mapped without copying by "open_mapped" of
+ * "NEDA_MAPPED_BODY_IMPLEMENTATION".
+ */
+#define NEDA_SNAPSHOT_HEADER_POSTFIX(_postfix, _type)                                   \
+  NEDA_DEF int neda_##_postfix##__save(struct neda_##_postfix *_da, const char *_path); \
+  NEDA_DEF int neda_##_postfix##__load(struct neda_##_postfix *_da, const char *_path);
+
+#define NEDA_SNAPSHOT_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)        \
+  /* Writes header and data of array to file at "_path", data is          \
+     written by one "fwrite". */                                          \
+  NEDA_API int neda_##_postfix##__save(                                   \
+      struct neda_##_postfix *_da,                                        \
+      const char *_path)                                                  \
+  {                                                                       \
+    struct neda_snapshot_header header;                                   \
+    FILE *file;                                                           \
+    int result = NEDA_SUCCESS;                                            \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                     \
+    neda_snapshot__make_header(                                           \
+        &header,                                                          \
+        sizeof(_type),                                                    \
+        _da->data,                                                        \
+        _da->size);                                                       \
+    file = fopen(_path, "wb");                                            \
+    if (!file)                                                            \
+    {                                                                     \
+      return NEDA_FAILURE;                                                \
+    }                                                                     \
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||                  \
+        (_da->size &&                                                     \
+         fwrite(_da->data, sizeof(_type), _da->size, file) != _da->size)) \
+    {                                                                     \
+      result = NEDA_FAILURE;                                              \
+    }                                                                     \
+    if (fclose(file) != 0)                                                \
+    {                                                                     \
+      result = NEDA_FAILURE;                                              \
+    }                                                                     \
+    return result;                                                        \
+  }                                                                       \
+  /* Replaces content of array by snapshot from file at "_path".          \
+     Array is left empty, if file is not snapshot of the same type,       \
+     it is shorter than count of header says or checksum does not         \
+     match. Length is checked before "reserve", so corrupted count        \
+     does not allocate memory. */                                         \
+  NEDA_API int neda_##_postfix##__load(                                   \
+      struct neda_##_postfix *_da,                                        \
+      const char *_path)                                                  \
+  {                                                                       \
+    struct neda_snapshot_header header;                                   \
+    size_t file_size;                                                     \
+    FILE *file;                                                           \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                     \
+    _da->size = 0;                                                        \
+    file = fopen(_path, "rb");                                            \
+    if (!file)                                                            \
+    {                                                                     \
+      return NEDA_FAILURE;                                                \
+    }                                                                     \
+    if (fread(&header, sizeof(header), 1, file) != 1 ||                   \
+        neda_snapshot__check_header(&header, sizeof(_type)) !=            \
+            NEDA_SUCCESS ||                                               \
+        neda_snapshot__file_size(file, &file_size) != NEDA_SUCCESS ||     \
+        file_size < sizeof(header) ||                                     \
+        header.count > (file_size - sizeof(header)) / sizeof(_type))      \
+    {                                                                     \
+      fclose(file);                                                       \
+      return NEDA_FAILURE;                                                \
+    }                                                                     \
+    neda_##_postfix##__reserve(_da, (nedasize_t)header.count);            \
+    if ((header.count &&                                                  \
+         fread(_da->data, sizeof(_type), header.count, file) !=           \
+             header.count) ||                                             \
+        neda_checksum(_da->data, sizeof(_type) * header.count) !=         \
+            header.checksum)                                              \
+    {                                                                     \
+      fclose(file);                                                       \
+      return NEDA_FAILURE;                                                \
+    }                                                                     \
+    fclose(file);                                                         \
+    _da->size = (nedasize_t)header.count;                                 \
+    return NEDA_SUCCESS;                                                  \
+  }
+
+#define NEDA_SNAPSHOT_HEADER(_type) NEDA_SNAPSHOT_HEADER_POSTFIX(_type, _type)
+#define NEDA_SNAPSHOT_BODY_IMPLEMENTATION(_type) NEDA_SNAPSHOT_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+
+/* Smallest capacity of struct-of-arrays columns. */
+#ifndef NEDA_SOA_MIN_CAPACITY
+#define NEDA_SOA_MIN_CAPACITY 16
+#endif
+
+/* Struct-of-arrays: every field of record is kept in it's own
+ * contiguous column, all columns share size and capacity, so scan of
+ * one field reads only bytes of this field. Fields are given by list
+ * macro, which calls "_field(_argument, type, name)" for every field.
+ * Rows are passed by value as "struct neda_soa_<name>__row", column of
+ * field is returned by function with name of field. Example:
+ *   #define POINT_FIELDS(_field, _argument) \
+ *     _field(_argument, float, x)           \
+ *     _field(_argument, float, y)           \
+ *     _field(_argument, int, id)
+ *   NEDA_SOA_HEADER(point, POINT_FIELDS)
+ *   NEDA_SOA_BODY_IMPLEMENTATION(point, POINT_FIELDS)
+ *   ...
+ *   struct neda_soa_point__row row = {1.0f, 2.0f, 3};
+ *   neda_soa_point__push_back(points, row);
+ *   xs = neda_soa_point__x(points);
+ */
+/* Expansions of field list of "NEDA_SOA_HEADER", every one is called
+ * as "_expansion(_argument, _type, _name)". */
+#define NEDA_SOA__MEMBER(_postfix, _type, _name) _type _name;
+#define NEDA_SOA__COLUMN(_postfix, _type, _name) _type *_name;
+#define NEDA_SOA__COLUMN_DEF(_postfix, _type, _name) \
+  NEDA_DEF _type *neda_soa_##_postfix##__##_name(struct neda_soa_##_postfix *_sa);
+#define NEDA_SOA__COLUMN_API(_postfix, _type, _name) \
+  NEDA_API _type *neda_soa_##_postfix##__##_name(    \
+      struct neda_soa_##_postfix *_sa)               \
+  {                                                  \
+    NEDA_ASSERT(_sa);                                \
+    return _sa->_name;                               \
+  }
+#define NEDA_SOA__INIT(_sa, _type, _name) (_sa)->_name = 0;
+#define NEDA_SOA__REALLOC(_sa, _type, _name) \
+  (_sa)->_name = (_type *)NEDA_REALLOC(      \
+      (_sa)->_name,                          \
+      sizeof(_type) * capacity);             \
+  NEDA_ASSERT((_sa)->_name);
+#define NEDA_SOA__STORE(_sa, _type, _name) (_sa)->_name[index] = _row._name;
+#define NEDA_SOA__LOAD(_sa, _type, _name) row._name = (_sa)->_name[index];
+#define NEDA_SOA__ERASE(_sa, _type, _name) \
+  memmove(                                 \
+      (_sa)->_name + _index,               \
+      (_sa)->_name + _index + 1,           \
+      sizeof(_type) * ((_sa)->size - _index - 1));
+#define NEDA_SOA__FREE(_sa, _type, _name) NEDA_FREE((_sa)->_name);
+/* Column is gathered into new buffer by "order", old one is freed. */
+#define NEDA_SOA__PERMUTE(_sa, _type, _name)                               \
+  {                                                                        \
+    _type *column = (_type *)NEDA_MALLOC(sizeof(_type) * (_sa)->capacity); \
+    NEDA_ASSERT(column);                                                   \
+    index = 0;                                                             \
+    while (index < (_sa)->size)                                            \
+    {                                                                      \
+      column[index] = (_sa)->_name[order[index]];                          \
+      index++;                                                             \
+    }                                                                      \
+    NEDA_FREE((_sa)->_name);                                               \
+    (_sa)->_name = column;                                                 \
+  }
+
+#define NEDA_SOA_HEADER(_postfix, _fields)                                                                     \
+  struct neda_soa_##_postfix##__row                                                                            \
+  {                                                                                                            \
+    _fields(NEDA_SOA__MEMBER, _postfix)                                                                        \
+  };                                                                                                           \
+  typedef struct neda_soa_##_postfix                                                                           \
+  {                                                                                                            \
+    _fields(NEDA_SOA__COLUMN, _postfix)                                                                        \
+    nedasize_t capacity, size;                                                                                 \
+  } neda_soa_##_postfix;                                                                                       \
+  typedef int (*neda_soa_##_postfix##__less_function_type)(                                                    \
+      const struct neda_soa_##_postfix *_sa, const nedasize_t _a, const nedasize_t _b);                        \
+  NEDA_DEF void neda_soa_##_postfix##__init(struct neda_soa_##_postfix **_sa);                                 \
+  NEDA_DEF void neda_soa_##_postfix##__reserve(struct neda_soa_##_postfix *_sa, const nedasize_t _size);       \
+  NEDA_DEF nedasize_t neda_soa_##_postfix##__size(struct neda_soa_##_postfix *_sa);                            \
+  NEDA_DEF nedasize_t neda_soa_##_postfix##__capacity(struct neda_soa_##_postfix *_sa);                        \
+  NEDA_DEF void neda_soa_##_postfix##__push_back(                                                              \
+      struct neda_soa_##_postfix *_sa, const struct neda_soa_##_postfix##__row _row);                          \
+  NEDA_DEF struct neda_soa_##_postfix##__row neda_soa_##_postfix##__pop_back(struct neda_soa_##_postfix *_sa); \
+  NEDA_DEF struct neda_soa_##_postfix##__row neda_soa_##_postfix##__at(                                        \
+      struct neda_soa_##_postfix *_sa, const nedasize_t _index);                                               \
+  NEDA_DEF void neda_soa_##_postfix##__set(                                                                    \
+      struct neda_soa_##_postfix *_sa, const nedasize_t _index, const struct neda_soa_##_postfix##__row _row); \
+  NEDA_DEF void neda_soa_##_postfix##__erase(struct neda_soa_##_postfix *_sa, const nedasize_t _index);        \
+  NEDA_DEF void neda_soa_##_postfix##__sort(                                                                   \
+      struct neda_soa_##_postfix *_sa, neda_soa_##_postfix##__less_function_type _less);                       \
+  NEDA_DEF void neda_soa_##_postfix##__clear(struct neda_soa_##_postfix *_sa);                                 \
+  NEDA_DEF void neda_soa_##_postfix##__free(struct neda_soa_##_postfix **_sa);                                 \
+  _fields(NEDA_SOA__COLUMN_DEF, _postfix)
+
+#define NEDA_SOA_BODY_IMPLEMENTATION(_postfix, _fields)                \
+  NEDA_API void neda_soa_##_postfix##__init(                           \
+      struct neda_soa_##_postfix **_sa)                                \
+  {                                                                    \
+    *_sa = (struct neda_soa_##_postfix *)NEDA_MALLOC(                  \
+        sizeof(struct neda_soa_##_postfix));                           \
+    NEDA_ASSERT(*_sa);                                                 \
+    _fields(NEDA_SOA__INIT, *_sa)                                      \
+    (*_sa)->capacity = 0;                                              \
+    (*_sa)->size = 0;                                                  \
+  }                                                                    \
+  /* Every column is reallocated to the same capacity. */              \
+  NEDA_API void neda_soa_##_postfix##__reserve(                        \
+      struct neda_soa_##_postfix *_sa,                                 \
+      const nedasize_t _size)                                          \
+  {                                                                    \
+    nedasize_t capacity;                                               \
+    NEDA_ASSERT(_sa);                                                  \
+    if (_size <= _sa->capacity)                                        \
+    {                                                                  \
+      return;                                                          \
+    }                                                                  \
+    capacity = _sa->capacity ? _sa->capacity : NEDA_SOA_MIN_CAPACITY;  \
+    while (capacity < _size)                                           \
+    {                                                                  \
+      capacity *= 2;                                                   \
+    }                                                                  \
+    _fields(NEDA_SOA__REALLOC, _sa)                                    \
+    _sa->capacity = capacity;                                          \
+  }                                                                    \
+  NEDA_API nedasize_t neda_soa_##_postfix##__size(                     \
+      struct neda_soa_##_postfix *_sa)                                 \
+  {                                                                    \
+    NEDA_ASSERT(_sa);                                                  \
+    return _sa->size;                                                  \
+  }                                                                    \
+  NEDA_API nedasize_t neda_soa_##_postfix##__capacity(                 \
+      struct neda_soa_##_postfix *_sa)                                 \
+  {                                                                    \
+    NEDA_ASSERT(_sa);                                                  \
+    return _sa->capacity;                                              \
+  }                                                                    \
+  NEDA_API void neda_soa_##_postfix##__push_back(                      \
+      struct neda_soa_##_postfix *_sa,                                 \
+      const struct neda_soa_##_postfix##__row _row)                    \
+  {                                                                    \
+    nedasize_t index;                                                  \
+    NEDA_ASSERT(_sa);                                                  \
+    neda_soa_##_postfix##__reserve(_sa, _sa->size + 1);                \
+    index = _sa->size;                                                 \
+    _fields(NEDA_SOA__STORE, _sa)                                      \
+    _sa->size++;                                                       \
+  }                                                                    \
+  NEDA_API struct neda_soa_##_postfix##__row                           \
+      neda_soa_##_postfix##__pop_back(                                 \
+          struct neda_soa_##_postfix *_sa)                             \
+  {                                                                    \
+    struct neda_soa_##_postfix##__row row;                             \
+    NEDA_ASSERT(_sa && _sa->size);                                     \
+    row = neda_soa_##_postfix##__at(_sa, _sa->size - 1);               \
+    _sa->size--;                                                       \
+    return row;                                                        \
+  }                                                                    \
+  /* Row is gathered from all columns. For scans of one field column   \
+     pointer (function with name of field) should be used. */          \
+  NEDA_API struct neda_soa_##_postfix##__row                           \
+      neda_soa_##_postfix##__at(                                       \
+          struct neda_soa_##_postfix *_sa,                             \
+          const nedasize_t _index)                                     \
+  {                                                                    \
+    struct neda_soa_##_postfix##__row row;                             \
+    const nedasize_t index = _index;                                   \
+    NEDA_ASSERT(_sa);                                                  \
+    NEDA_ASSERT(_index < _sa->size);                                   \
+    _fields(NEDA_SOA__LOAD, _sa)                                       \
+    return row;                                                        \
+  }                                                                    \
+  NEDA_API void neda_soa_##_postfix##__set(                            \
+      struct neda_soa_##_postfix *_sa,                                 \
+      const nedasize_t _index,                                         \
+      const struct neda_soa_##_postfix##__row _row)                    \
+  {                                                                    \
+    const nedasize_t index = _index;                                   \
+    NEDA_ASSERT(_sa);                                                  \
+    NEDA_ASSERT(_index < _sa->size);                                   \
+    _fields(NEDA_SOA__STORE, _sa)                                      \
+  }                                                                    \
+  NEDA_API void neda_soa_##_postfix##__erase(                          \
+      struct neda_soa_##_postfix *_sa,                                 \
+      const nedasize_t _index)                                         \
+  {                                                                    \
+    NEDA_ASSERT(_sa);                                                  \
+    NEDA_ASSERT(_index < _sa->size);                                   \
+    _fields(NEDA_SOA__ERASE, _sa)                                      \
+    _sa->size--;                                                       \
+  }                                                                    \
+  /* Context of sorting of row indices. */                             \
+  struct neda_soa_##_postfix##__sort_context                           \
+  {                                                                    \
+    const struct neda_soa_##_postfix *sa;                              \
+    neda_soa_##_postfix##__less_function_type less;                    \
+  };                                                                   \
+  NEDA_INTERNAL int neda_soa_##_postfix##__less(                       \
+      const struct neda_soa_##_postfix##__sort_context *_context,      \
+      const nedasize_t *_a,                                            \
+      const nedasize_t *_b)                                            \
+  {                                                                    \
+    return _context->less(_context->sa, *_a, *_b);                     \
+  }                                                                    \
+  NEDA_SORT_ENGINE(                                                    \
+      neda_soa_##_postfix##__sort_engine,                              \
+      nedasize_t,                                                      \
+      struct neda_soa_##_postfix##__sort_context,                      \
+      neda_soa_##_postfix##__less)                                     \
+  /* Row indices are sorted by "_less", which compares rows "_a" and   \
+     "_b" by columns of "_sa". Then every column is gathered in sorted \
+     order, so every column is moved once. */                          \
+  NEDA_API void neda_soa_##_postfix##__sort(                           \
+      struct neda_soa_##_postfix *_sa,                                 \
+      neda_soa_##_postfix##__less_function_type _less)                 \
+  {                                                                    \
+    struct neda_soa_##_postfix##__sort_context context;                \
+    nedasize_t *order;                                                 \
+    nedasize_t index = 0;                                              \
+    NEDA_ASSERT(_sa && _less);                                         \
+    if (_sa->size < 2)                                                 \
+    {                                                                  \
+      return;                                                          \
+    }                                                                  \
+    order = (nedasize_t *)NEDA_MALLOC(sizeof(nedasize_t) * _sa->size); \
+    NEDA_ASSERT(order);                                                \
+    while (index < _sa->size)                                          \
+    {                                                                  \
+      order[index] = index;                                            \
+      index++;                                                         \
+    }                                                                  \
+    context.sa = _sa;                                                  \
+    context.less = _less;                                              \
+    neda_soa_##_postfix##__sort_engine_range(                          \
+        order,                                                         \
+        order + _sa->size,                                             \
+        &context);                                                     \
+    _fields(NEDA_SOA__PERMUTE, _sa)                                    \
+    NEDA_FREE(order);                                                  \
+  }                                                                    \
+  NEDA_API void neda_soa_##_postfix##__clear(                          \
+      struct neda_soa_##_postfix *_sa)                                 \
+  {                                                                    \
+    NEDA_ASSERT(_sa);                                                  \
+    _sa->size = 0;                                                     \
+  }                                                                    \
+  NEDA_API void neda_soa_##_postfix##__free(                           \
+      struct neda_soa_##_postfix **_sa)                                \
+  {                                                                    \
+    NEDA_ASSERT(_sa && *_sa);                                          \
+    _fields(NEDA_SOA__FREE, *_sa)                                      \
+    NEDA_FREE(*_sa);                                                   \
+    *_sa = 0;                                                          \
+  }                                                                    \
+  _fields(NEDA_SOA__COLUMN_API, _postfix)
+
+/* Position of handle, which is not in indexed heap. */
+#define NEDA_HEAP_NONE ((nedasize_t)-1)
+
+/* Binary heap (priority queue) over neda and indexed heap
+ * "neda_iheap_". Root of heap is element, which "sort" places first,
+ * so comparator of array (or "_less_expression" of
+ * NEDA_BODY_IMPLEMENTATION_CMP) is used. "_arity" is count of children
+ * of every node: 4-ary heap is lower and it's children share cache
+ * line, so "heap_pop" touches less lines, than binary one. Indexed
+ * heap gives handle for every pushed value, value can be moved towards
+ * root by "decrease_key" (Dijkstra, timers). Sifting moves elements by
+ * assignment, swap and move functions of array are not used. Regular
+ * neda of the same type should be generated too. Example:
+ *   NEDA_HEADER(int)
+ *   NEDA_BODY_IMPLEMENTATION(int, 128)
+ *   NEDA_HEAP_HEADER(int)
+ *   NEDA_HEAP_BODY_IMPLEMENTATION_ARITY(int, 4)
+ *   ...
+ *   neda_int__heap_push(da, 5);
+ *   first = neda_int__heap_pop(da);
+ */
+#define NEDA_HEAP_HEADER_POSTFIX(_postfix, _type)                                                                \
+  typedef struct neda_iheap_##_postfix                                                                           \
+  {                                                                                                              \
+    struct neda_##_postfix *values;                                                                              \
+    nedasize_t *heap, *positions, *free_handles;                                                                 \
+    nedasize_t size, capacity, free_count;                                                                       \
+  } neda_iheap_##_postfix;                                                                                       \
+  NEDA_DEF void neda_##_postfix##__make_heap(struct neda_##_postfix *_da);                                       \
+  NEDA_DEF void neda_##_postfix##__heap_push(struct neda_##_postfix *_da, const _type _value);                   \
+  NEDA_DEF _type neda_##_postfix##__heap_pop(struct neda_##_postfix *_da);                                       \
+  NEDA_DEF _type neda_##_postfix##__heap_top(struct neda_##_postfix *_da);                                       \
+  NEDA_DEF int neda_##_postfix##__is_heap(struct neda_##_postfix *_da);                                          \
+  NEDA_DEF void neda_iheap_##_postfix##__init(struct neda_iheap_##_postfix **_heap);                             \
+  NEDA_DEF nedasize_t neda_iheap_##_postfix##__push(struct neda_iheap_##_postfix *_heap, const _type _value);    \
+  NEDA_DEF _type neda_iheap_##_postfix##__top(struct neda_iheap_##_postfix *_heap);                              \
+  NEDA_DEF nedasize_t neda_iheap_##_postfix##__top_handle(struct neda_iheap_##_postfix *_heap);                  \
+  NEDA_DEF _type neda_iheap_##_postfix##__pop(struct neda_iheap_##_postfix *_heap);                              \
+  NEDA_DEF void neda_iheap_##_postfix##__decrease_key(                                                           \
+      struct neda_iheap_##_postfix *_heap, const nedasize_t _handle, const _type _value);                        \
+  NEDA_DEF int neda_iheap_##_postfix##__contains(struct neda_iheap_##_postfix *_heap, const nedasize_t _handle); \
+  NEDA_DEF _type neda_iheap_##_postfix##__value(struct neda_iheap_##_postfix *_heap, const nedasize_t _handle);  \
+  NEDA_DEF nedasize_t neda_iheap_##_postfix##__size(struct neda_iheap_##_postfix *_heap);                        \
+  NEDA_DEF void neda_iheap_##_postfix##__free(struct neda_iheap_##_postfix **_heap);
+
+#define NEDA_HEAP_BODY_IMPLEMENTATION_ARITY_POSTFIX(_postfix, _type, _arity) \
+  /* Moves element "_index" to the root, while it should be placed           \
+     before it's parent. */                                                  \
+  NEDA_INTERNAL void neda_##_postfix##__heap_sift_up(                        \
+      _type *_data,                                                          \
+      nedasize_t _index,                                                     \
+      const struct neda_##_postfix##__functions *_functions)                 \
+  {                                                                          \
+    const _type value = _data[_index];                                       \
+    NEDA_REGISTER nedasize_t parent;                                         \
+    while (_index > 0)                                                       \
+    {                                                                        \
+      parent = (_index - 1) / (_arity);                                      \
+      if (!neda_##_postfix##__less(_functions, &value, &_data[parent]))      \
+      {                                                                      \
+        break;                                                               \
+      }                                                                      \
+      _data[_index] = _data[parent];                                         \
+      _index = parent;                                                       \
+    }                                                                        \
+    _data[_index] = value;                                                   \
+  }                                                                          \
+  /* Moves element "_index" down, while one of it's "_arity" children        \
+     should be placed before it. */                                          \
+  NEDA_INTERNAL void neda_##_postfix##__heap_sift_down(                      \
+      _type *_data,                                                          \
+      nedasize_t _index,                                                     \
+      const nedasize_t _size,                                                \
+      const struct neda_##_postfix##__functions *_functions)                 \
+  {                                                                          \
+    const _type value = _data[_index];                                       \
+    NEDA_REGISTER nedasize_t child, best;                                    \
+    nedasize_t last;                                                         \
+    while ((child = _index * (_arity) + 1) < _size)                          \
+    {                                                                        \
+      best = child;                                                          \
+      last = _size - child > (_arity) ? child + (_arity) : _size;            \
+      while (++child < last)                                                 \
+      {                                                                      \
+        if (neda_##_postfix##__less(                                         \
+                _functions,                                                  \
+                &_data[child],                                               \
+                &_data[best]))                                               \
+        {                                                                    \
+          best = child;                                                      \
+        }                                                                    \
+      }                                                                      \
+      if (!neda_##_postfix##__less(_functions, &_data[best], &value))        \
+      {                                                                      \
+        break;                                                               \
+      }                                                                      \
+      _data[_index] = _data[best];                                           \
+      _index = best;                                                         \
+    }                                                                        \
+    _data[_index] = value;                                                   \
+  }                                                                          \
+  /* Reorders array into heap in O(n). */                                    \
+  NEDA_API void neda_##_postfix##__make_heap(                                \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    NEDA_REGISTER nedasize_t i;                                              \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    if (_da->size < 2)                                                       \
+    {                                                                        \
+      return;                                                                \
+    }                                                                        \
+    neda_##_postfix##__get_functions(_da, &functions);                       \
+    i = (_da->size - 2) / (_arity) + 1;                                      \
+    while (i > 0)                                                            \
+    {                                                                        \
+      i--;                                                                   \
+      neda_##_postfix##__heap_sift_down(                                     \
+          _da->data,                                                         \
+          i,                                                                 \
+          _da->size,                                                         \
+          &functions);                                                       \
+    }                                                                        \
+  }                                                                          \
+  NEDA_API void neda_##_postfix##__heap_push(                                \
+      struct neda_##_postfix *_da,                                           \
+      const _type _value)                                                    \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    neda_##_postfix##__get_functions(_da, &functions);                       \
+    neda_##_postfix##__push_back(_da, _value);                               \
+    neda_##_postfix##__heap_sift_up(                                         \
+        _da->data,                                                           \
+        _da->size - 1,                                                       \
+        &functions);                                                         \
+  }                                                                          \
+  /* Removes root of heap. \returns removed element. */                      \
+  NEDA_API _type neda_##_postfix##__heap_pop(                                \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    _type top, last;                                                         \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    NEDA_ASSERT(_da->size);                                                  \
+    last = neda_##_postfix##__pop_back(_da);                                 \
+    if (!_da->size)                                                          \
+    {                                                                        \
+      return last;                                                           \
+    }                                                                        \
+    neda_##_postfix##__get_functions(_da, &functions);                       \
+    top = _da->data[0];                                                      \
+    _da->data[0] = last;                                                     \
+    neda_##_postfix##__heap_sift_down(                                       \
+        _da->data,                                                           \
+        0,                                                                   \
+        _da->size,                                                           \
+        &functions);                                                         \
+    return top;                                                              \
+  }                                                                          \
+  /* \returns root of heap: element, which "sort" places first. */           \
+  NEDA_API _type neda_##_postfix##__heap_top(                                \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    NEDA_ASSERT(_da->size);                                                  \
+    return _da->data[0];                                                     \
+  }                                                                          \
+  /* \returns logical true, if no element should be placed before it's       \
+     parent. */                                                              \
+  NEDA_API int neda_##_postfix##__is_heap(                                   \
+      struct neda_##_postfix *_da)                                           \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    NEDA_REGISTER nedasize_t i = 1;                                          \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                        \
+    neda_##_postfix##__get_functions(_da, &functions);                       \
+    while (i < _da->size)                                                    \
+    {                                                                        \
+      if (neda_##_postfix##__less(                                           \
+              &functions,                                                    \
+              &_da->data[i],                                                 \
+              &_da->data[(i - 1) / (_arity)]))                               \
+      {                                                                      \
+        return 0;                                                            \
+      }                                                                      \
+      i++;                                                                   \
+    }                                                                        \
+    return 1;                                                                \
+  }                                                                          \
+  /* Indexed heap keeps handles of values, so position of every value        \
+     is known and it can be moved by "decrease_key". */                      \
+  NEDA_INTERNAL void neda_iheap_##_postfix##__sift_up(                       \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      nedasize_t _index,                                                     \
+      const struct neda_##_postfix##__functions *_functions)                 \
+  {                                                                          \
+    const nedasize_t handle = _heap->heap[_index];                           \
+    const _type *values = _heap->values->data;                               \
+    NEDA_REGISTER nedasize_t parent;                                         \
+    while (_index > 0)                                                       \
+    {                                                                        \
+      parent = (_index - 1) / (_arity);                                      \
+      if (!neda_##_postfix##__less(                                          \
+              _functions,                                                    \
+              &values[handle],                                               \
+              &values[_heap->heap[parent]]))                                 \
+      {                                                                      \
+        break;                                                               \
+      }                                                                      \
+      _heap->heap[_index] = _heap->heap[parent];                             \
+      _heap->positions[_heap->heap[_index]] = _index;                        \
+      _index = parent;                                                       \
+    }                                                                        \
+    _heap->heap[_index] = handle;                                            \
+    _heap->positions[handle] = _index;                                       \
+  }                                                                          \
+  NEDA_INTERNAL void neda_iheap_##_postfix##__sift_down(                     \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      nedasize_t _index,                                                     \
+      const struct neda_##_postfix##__functions *_functions)                 \
+  {                                                                          \
+    const nedasize_t handle = _heap->heap[_index];                           \
+    const _type *values = _heap->values->data;                               \
+    NEDA_REGISTER nedasize_t child, best;                                    \
+    nedasize_t last;                                                         \
+    while ((child = _index * (_arity) + 1) < _heap->size)                    \
+    {                                                                        \
+      best = child;                                                          \
+      last = _heap->size - child > (_arity) ? child + (_arity)               \
+                                            : _heap->size;                   \
+      while (++child < last)                                                 \
+      {                                                                      \
+        if (neda_##_postfix##__less(                                         \
+                _functions,                                                  \
+                &values[_heap->heap[child]],                                 \
+                &values[_heap->heap[best]]))                                 \
+        {                                                                    \
+          best = child;                                                      \
+        }                                                                    \
+      }                                                                      \
+      if (!neda_##_postfix##__less(                                          \
+              _functions,                                                    \
+              &values[_heap->heap[best]],                                    \
+              &values[handle]))                                              \
+      {                                                                      \
+        break;                                                               \
+      }                                                                      \
+      _heap->heap[_index] = _heap->heap[best];                               \
+      _heap->positions[_heap->heap[_index]] = _index;                        \
+      _index = best;                                                         \
+    }                                                                        \
+    _heap->heap[_index] = handle;                                            \
+    _heap->positions[handle] = _index;                                       \
+  }                                                                          \
+  NEDA_API void neda_iheap_##_postfix##__init(                               \
+      struct neda_iheap_##_postfix **_heap)                                  \
+  {                                                                          \
+    *_heap = (struct neda_iheap_##_postfix *)NEDA_MALLOC(                    \
+        sizeof(struct neda_iheap_##_postfix));                               \
+    NEDA_ASSERT(*_heap);                                                     \
+    neda_##_postfix##__init(&(*_heap)->values);                              \
+    (*_heap)->heap = 0;                                                      \
+    (*_heap)->positions = 0;                                                 \
+    (*_heap)->free_handles = 0;                                              \
+    (*_heap)->size = 0;                                                      \
+    (*_heap)->capacity = 0;                                                  \
+    (*_heap)->free_count = 0;                                                \
+  }                                                                          \
+  /* \returns handle of pushed value, it is valid until value is             \
+     popped. Handles of popped values are reused. */                         \
+  NEDA_API nedasize_t neda_iheap_##_postfix##__push(                         \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      const _type _value)                                                    \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    nedasize_t handle;                                                       \
+    NEDA_ASSERT(_heap);                                                      \
+    if (_heap->free_count)                                                   \
+    {                                                                        \
+      handle = _heap->free_handles[--_heap->free_count];                     \
+      _heap->values->data[handle] = _value;                                  \
+    }                                                                        \
+    else                                                                     \
+    {                                                                        \
+      handle = _heap->values->size;                                          \
+      neda_##_postfix##__push_back(_heap->values, _value);                   \
+      if (_heap->capacity < _heap->values->capacity)                         \
+      {                                                                      \
+        _heap->capacity = _heap->values->capacity;                           \
+        _heap->heap = (nedasize_t *)NEDA_REALLOC(                            \
+            _heap->heap,                                                     \
+            sizeof(nedasize_t) * _heap->capacity);                           \
+        _heap->positions = (nedasize_t *)NEDA_REALLOC(                       \
+            _heap->positions,                                                \
+            sizeof(nedasize_t) * _heap->capacity);                           \
+        _heap->free_handles = (nedasize_t *)NEDA_REALLOC(                    \
+            _heap->free_handles,                                             \
+            sizeof(nedasize_t) * _heap->capacity);                           \
+        NEDA_ASSERT(_heap->heap && _heap->positions &&                       \
+                    _heap->free_handles);                                    \
+      }                                                                      \
+    }                                                                        \
+    neda_##_postfix##__get_functions(_heap->values, &functions);             \
+    _heap->heap[_heap->size] = handle;                                       \
+    _heap->size++;                                                           \
+    neda_iheap_##_postfix##__sift_up(                                        \
+        _heap,                                                               \
+        _heap->size - 1,                                                     \
+        &functions);                                                         \
+    return handle;                                                           \
+  }                                                                          \
+  NEDA_API _type neda_iheap_##_postfix##__top(                               \
+      struct neda_iheap_##_postfix *_heap)                                   \
+  {                                                                          \
+    NEDA_ASSERT(_heap && _heap->size);                                       \
+    return _heap->values->data[_heap->heap[0]];                              \
+  }                                                                          \
+  NEDA_API nedasize_t neda_iheap_##_postfix##__top_handle(                   \
+      struct neda_iheap_##_postfix *_heap)                                   \
+  {                                                                          \
+    NEDA_ASSERT(_heap && _heap->size);                                       \
+    return _heap->heap[0];                                                   \
+  }                                                                          \
+  /* Removes root of heap, it's handle becomes free. \returns removed        \
+     value. */                                                               \
+  NEDA_API _type neda_iheap_##_postfix##__pop(                               \
+      struct neda_iheap_##_postfix *_heap)                                   \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    nedasize_t handle;                                                       \
+    NEDA_ASSERT(_heap && _heap->size);                                       \
+    handle = _heap->heap[0];                                                 \
+    _heap->positions[handle] = NEDA_HEAP_NONE;                               \
+    _heap->free_handles[_heap->free_count++] = handle;                       \
+    _heap->size--;                                                           \
+    if (_heap->size)                                                         \
+    {                                                                        \
+      neda_##_postfix##__get_functions(_heap->values, &functions);           \
+      _heap->heap[0] = _heap->heap[_heap->size];                             \
+      neda_iheap_##_postfix##__sift_down(_heap, 0, &functions);              \
+    }                                                                        \
+    return _heap->values->data[handle];                                      \
+  }                                                                          \
+  /* Replaces value of "_handle" by "_value", which "sort" does not          \
+     place after old value, and moves it towards root. */                    \
+  NEDA_API void neda_iheap_##_postfix##__decrease_key(                       \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      const nedasize_t _handle,                                              \
+      const _type _value)                                                    \
+  {                                                                          \
+    struct neda_##_postfix##__functions functions;                           \
+    NEDA_ASSERT(neda_iheap_##_postfix##__contains(_heap, _handle));          \
+    neda_##_postfix##__get_functions(_heap->values, &functions);             \
+    NEDA_ASSERT(!neda_##_postfix##__less(                                    \
+        &functions,                                                          \
+        &_heap->values->data[_handle],                                       \
+        &_value));                                                           \
+    _heap->values->data[_handle] = _value;                                   \
+    neda_iheap_##_postfix##__sift_up(                                        \
+        _heap,                                                               \
+        _heap->positions[_handle],                                           \
+        &functions);                                                         \
+  }                                                                          \
+  /* \returns logical true, if value of "_handle" is in heap. */             \
+  NEDA_API int neda_iheap_##_postfix##__contains(                            \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      const nedasize_t _handle)                                              \
+  {                                                                          \
+    NEDA_ASSERT(_heap);                                                      \
+    return _handle < _heap->values->size &&                                  \
+           _heap->positions[_handle] != NEDA_HEAP_NONE;                      \
+  }                                                                          \
+  NEDA_API _type neda_iheap_##_postfix##__value(                             \
+      struct neda_iheap_##_postfix *_heap,                                   \
+      const nedasize_t _handle)                                              \
+  {                                                                          \
+    NEDA_ASSERT(neda_iheap_##_postfix##__contains(_heap, _handle));          \
+    return _heap->values->data[_handle];                                     \
+  }                                                                          \
+  NEDA_API nedasize_t neda_iheap_##_postfix##__size(                         \
+      struct neda_iheap_##_postfix *_heap)                                   \
+  {                                                                          \
+    NEDA_ASSERT(_heap);                                                      \
+    return _heap->size;                                                      \
+  }                                                                          \
+  NEDA_API void neda_iheap_##_postfix##__free(                               \
+      struct neda_iheap_##_postfix **_heap)                                  \
+  {                                                                          \
+    NEDA_ASSERT(_heap && *_heap);                                            \
+    neda_##_postfix##__free(&(*_heap)->values);                              \
+    NEDA_FREE((*_heap)->heap);                                               \
+    NEDA_FREE((*_heap)->positions);                                          \
+    NEDA_FREE((*_heap)->free_handles);                                       \
+    NEDA_FREE(*_heap);                                                       \
+    *_heap = 0;                                                              \
+  }
+
+#define NEDA_HEAP_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type) \
+  NEDA_HEAP_BODY_IMPLEMENTATION_ARITY_POSTFIX(_postfix, _type, 2)
+
+#define NEDA_HEAP_HEADER(_type) NEDA_HEAP_HEADER_POSTFIX(_type, _type)
+#define NEDA_HEAP_BODY_IMPLEMENTATION(_type) NEDA_HEAP_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+#define NEDA_HEAP_BODY_IMPLEMENTATION_ARITY(_type, _arity) \
+  NEDA_HEAP_BODY_IMPLEMENTATION_ARITY_POSTFIX(_type, _type, _arity)
+
+/* Bitset is stored in words of this type. */
+#define NEDA_BITSET_WORD_BITS (sizeof(unsigned long) * 8)
+
+/* Count of words, which share one entry of rank directory. */
+#ifndef NEDA_BITSET_RANK_WORDS
+#define NEDA_BITSET_RANK_WORDS 8
+#endif
+
+/* "count" is compiled with POPCNT instruction, if NEDA_SIMD is defined
+ * and processor has it. */
+#if defined(NEDA_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NEDA_POPCOUNT_DISPATCH __attribute__((target_clones("popcnt", "default")))
+#else
+#define NEDA_POPCOUNT_DISPATCH
+#endif
+
+/* Packed bitset: bit per element, "unsigned long" words are processed
+ * at once by "and", "or", "xor", "andnot", "count" and "find_next".
+ * Bits after size in the last word are always zero. "rank" and
+ * "select" need rank directory (count of set bits before every
+ * NEDA_BITSET_RANK_WORDS words), which is built by "build_rank" and
+ * dropped by every change of bitset. Example:
+ *   struct neda_bitset bs;
+ *   neda_bitset__init(&bs);
+ *   neda_bitset__resize(&bs, 1000000);
+ *   neda_bitset__set(&bs, 42);
+ *   index = neda_bitset__find_next(&bs, 0);
+ *   neda_bitset__destroy(&bs);
+ */
+typedef struct neda_bitset
+{
+  unsigned long *words;
+  nedasize_t size, capacity;
+  nedasize_t *ranks;
+  int ranks_valid;
+} neda_bitset;
+
+/* \returns count of set bits in "_word". */
+NEDA_COMMON unsigned int neda_bitset__popcount(unsigned long _word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned int)__builtin_popcountl(_word);
+#else
+  unsigned int count = 0;
+  while (_word)
+  {
+    _word &= _word - 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/* \returns index of the lowest set bit of "_word", which is not 0. */
+NEDA_COMMON unsigned int neda_bitset__lowest(unsigned long _word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned int)__builtin_ctzl(_word);
+#else
+  unsigned int index = 0;
+  while (!(_word & 1UL))
+  {
+    _word >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+NEDA_COMMON nedasize_t neda_bitset__words(const nedasize_t _bits)
+{
+  return (nedasize_t)((_bits + NEDA_BITSET_WORD_BITS - 1) / NEDA_BITSET_WORD_BITS);
+}
+
+NEDA_COMMON void neda_bitset__init(struct neda_bitset *_bs)
+{
+  NEDA_ASSERT(_bs);
+  _bs->words = 0;
+  _bs->size = 0;
+  _bs->capacity = 0;
+  _bs->ranks = 0;
+  _bs->ranks_valid = 0;
+}
+
+NEDA_COMMON void neda_bitset__destroy(struct neda_bitset *_bs)
+{
+  NEDA_ASSERT(_bs);
+  NEDA_FREE(_bs->words);
+  NEDA_FREE(_bs->ranks);
+  neda_bitset__init(_bs);
+}
+
+/* Reserves words for "_bits" bits, capacity is counted in words. */
+NEDA_COMMON void neda_bitset__reserve(struct neda_bitset *_bs, const nedasize_t _bits)
+{
+  nedasize_t capacity;
+  NEDA_ASSERT(_bs);
+  if (neda_bitset__words(_bits) <= _bs->capacity)
+  {
+    return;
+  }
+  capacity = _bs->capacity ? _bs->capacity : 1;
+  while (capacity < neda_bitset__words(_bits))
+  {
+    capacity *= 2;
+  }
+  _bs->words = (unsigned long *)NEDA_REALLOC(_bs->words, sizeof(unsigned long) * capacity);
+  NEDA_ASSERT(_bs->words);
+  _bs->capacity = capacity;
+}
+
+/* Changes size to "_bits", new bits are zero. */
+NEDA_COMMON void neda_bitset__resize(struct neda_bitset *_bs, const nedasize_t _bits)
+{
+  nedasize_t used;
+  NEDA_ASSERT(_bs);
+  used = neda_bitset__words(_bs->size);
+  neda_bitset__reserve(_bs, _bits);
+  if (_bits > _bs->size)
+  {
+    memset(_bs->words + used, 0, sizeof(unsigned long) * (neda_bitset__words(_bits) - used));
+  }
+  else if (_bits % NEDA_BITSET_WORD_BITS)
+  {
+    _bs->words[_bits / NEDA_BITSET_WORD_BITS] &= (1UL << (_bits % NEDA_BITSET_WORD_BITS)) - 1;
+  }
+  _bs->size = _bits;
+  _bs->ranks_valid = 0;
+}
+
+NEDA_COMMON nedasize_t neda_bitset__size(const struct neda_bitset *_bs)
+{
+  NEDA_ASSERT(_bs);
+  return _bs->size;
+}
+
+/* Removes all bits, memory is kept. */
+NEDA_COMMON void neda_bitset__clear(struct neda_bitset *_bs)
+{
+  NEDA_ASSERT(_bs);
+  _bs->size = 0;
+  _bs->ranks_valid = 0;
+}
+
+NEDA_COMMON void neda_bitset__push_back(struct neda_bitset *_bs, const int _value)
+{
+  NEDA_ASSERT(_bs);
+  if (!(_bs->size % NEDA_BITSET_WORD_BITS))
+  {
+    neda_bitset__reserve(_bs, _bs->size + 1);
+    _bs->words[_bs->size / NEDA_BITSET_WORD_BITS] = 0;
+  }
+  _bs->words[_bs->size / NEDA_BITSET_WORD_BITS] |=
+      (unsigned long)(_value != 0) << (_bs->size % NEDA_BITSET_WORD_BITS);
+  _bs->size++;
+  _bs->ranks_valid = 0;
+}
+
+NEDA_COMMON void neda_bitset__set(struct neda_bitset *_bs, const nedasize_t _index)
+{
+  NEDA_ASSERT(_bs && _index < _bs->size);
+  _bs->words[_index / NEDA_BITSET_WORD_BITS] |= 1UL << (_index % NEDA_BITSET_WORD_BITS);
+  _bs->ranks_valid = 0;
+}
+
+NEDA_COMMON void neda_bitset__reset(struct neda_bitset *_bs, const nedasize_t _index)
+{
+  NEDA_ASSERT(_bs && _index < _bs->size);
+  _bs->words[_index / NEDA_BITSET_WORD_BITS] &= ~(1UL << (_index % NEDA_BITSET_WORD_BITS));
+  _bs->ranks_valid = 0;
+}
+
+/* \returns logical true, if bit "_index" is set. */
+NEDA_COMMON int neda_bitset__test(const struct neda_bitset *_bs, const nedasize_t _index)
+{
+  NEDA_ASSERT(_bs && _index < _bs->size);
+  return (int)((_bs->words[_index / NEDA_BITSET_WORD_BITS] >> (_index % NEDA_BITSET_WORD_BITS)) & 1UL);
+}
+
+/* Word-wise operations: "_bs" becomes "_bs" op "_other", both bitsets
+ * should have the same size. */
+#define NEDA_BITSET_OPERATION(_name, _expression)            \
+  NEDA_COMMON NEDA_SIMD_DISPATCH void neda_bitset__##_name(  \
+      struct neda_bitset *_bs,                               \
+      const struct neda_bitset *_other)                      \
+  {                                                          \
+    unsigned long *words;                                    \
+    const unsigned long *other;                              \
+    NEDA_REGISTER nedasize_t i = 0;                          \
+    nedasize_t count;                                        \
+    NEDA_ASSERT(_bs && _other && _bs->size == _other->size); \
+    words = _bs->words;                                      \
+    other = _other->words;                                   \
+    count = neda_bitset__words(_bs->size);                   \
+    while (i < count)                                        \
+    {                                                        \
+      words[i] = _expression;                                \
+      i++;                                                   \
+    }                                                        \
+    _bs->ranks_valid = 0;                                    \
+  }
+NEDA_BITSET_OPERATION(and, words[i] & other[i])
+NEDA_BITSET_OPERATION(or, words[i] | other[i])
+NEDA_BITSET_OPERATION(xor, words[i] ^ other[i])
+NEDA_BITSET_OPERATION(andnot, words[i] & ~other[i])
+
+/* \returns count of set bits. */
+NEDA_COMMON NEDA_POPCOUNT_DISPATCH nedasize_t neda_bitset__count(const struct neda_bitset *_bs)
+{
+  NEDA_REGISTER nedasize_t i = 0, result = 0;
+  nedasize_t count;
+  NEDA_ASSERT(_bs);
+  count = neda_bitset__words(_bs->size);
+  while (i < count)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    result += (nedasize_t)__builtin_popcountl(_bs->words[i]);
+#else
+    result += neda_bitset__popcount(_bs->words[i]);
+#endif
+    i++;
+  }
+  return result;
+}
+
+/* \returns index of the first set bit, which is not less than "_from",
+ * or size of bitset, if there is no such bit. Zero words are skipped
+ * at once. */
+NEDA_COMMON nedasize_t neda_bitset__find_next(const struct neda_bitset *_bs, const nedasize_t _from)
+{
+  NEDA_REGISTER nedasize_t word;
+  nedasize_t count;
+  unsigned long bits;
+  NEDA_ASSERT(_bs);
+  if (_from >= _bs->size)
+  {
+    return _bs->size;
+  }
+  count = neda_bitset__words(_bs->size);
+  word = _from / NEDA_BITSET_WORD_BITS;
+  bits = _bs->words[word] & (~0UL << (_from % NEDA_BITSET_WORD_BITS));
+  while (!bits)
+  {
+    if (++word == count)
+    {
+      return _bs->size;
+    }
+    bits = _bs->words[word];
+  }
+  return word * (nedasize_t)NEDA_BITSET_WORD_BITS + neda_bitset__lowest(bits);
+}
+
+/* \returns count of blocks of rank directory. */
+NEDA_COMMON nedasize_t neda_bitset__rank_blocks(const struct neda_bitset *_bs)
+{
+  return (neda_bitset__words(_bs->size) + NEDA_BITSET_RANK_WORDS - 1) / NEDA_BITSET_RANK_WORDS;
+}
+
+/* Builds rank directory, it is needed by "rank" and "select" and
+ * takes one nedasize_t per NEDA_BITSET_RANK_WORDS words. The last
+ * entry is count of all set bits. */
+NEDA_COMMON void neda_bitset__build_rank(struct neda_bitset *_bs)
+{
+  NEDA_REGISTER nedasize_t i = 0, total = 0;
+  nedasize_t count, blocks;
+  NEDA_ASSERT(_bs);
+  count = neda_bitset__words(_bs->size);
+  blocks = neda_bitset__rank_blocks(_bs);
+  _bs->ranks = (nedasize_t *)NEDA_REALLOC(
+      _bs->ranks,
+      sizeof(nedasize_t) * (blocks + 1));
+  NEDA_ASSERT(_bs->ranks);
+  while (i < count)
+  {
+    if (!(i % NEDA_BITSET_RANK_WORDS))
+    {
+      _bs->ranks[i / NEDA_BITSET_RANK_WORDS] = total;
+    }
+    total += neda_bitset__popcount(_bs->words[i]);
+    i++;
+  }
+  _bs->ranks[blocks] = total;
+  _bs->ranks_valid = 1;
+}
+
+/* \returns count of set bits before "_index". Directory gives count
+ * before block, so at most NEDA_BITSET_RANK_WORDS words are counted. */
+NEDA_COMMON nedasize_t neda_bitset__rank(const struct neda_bitset *_bs, const nedasize_t _index)
+{
+  NEDA_REGISTER nedasize_t word, result;
+  nedasize_t last;
+  NEDA_ASSERT(_bs && _bs->ranks_valid && _index <= _bs->size);
+  last = _index / NEDA_BITSET_WORD_BITS;
+  word = last / NEDA_BITSET_RANK_WORDS * NEDA_BITSET_RANK_WORDS;
+  result = _bs->ranks[last / NEDA_BITSET_RANK_WORDS];
+  while (word < last)
+  {
+    result += neda_bitset__popcount(_bs->words[word]);
+    word++;
+  }
+  if (_index % NEDA_BITSET_WORD_BITS)
+  {
+    result += neda_bitset__popcount(
+        _bs->words[last] & ((1UL << (_index % NEDA_BITSET_WORD_BITS)) - 1));
+  }
+  return result;
+}
+
+/* \returns index of set bit number "_rank" (from zero), or size of
+ * bitset, if there are not so many set bits. Block is found by binary
+ * search in rank directory. */
+NEDA_COMMON nedasize_t neda_bitset__select(const struct neda_bitset *_bs, nedasize_t _rank)
+{
+  NEDA_REGISTER nedasize_t low = 0, high, middle, word;
+  unsigned long bits;
+  unsigned int popcount;
+  NEDA_ASSERT(_bs && _bs->ranks_valid);
+  high = neda_bitset__rank_blocks(_bs);
+  if (_rank >= _bs->ranks[high])
+  {
+    return _bs->size;
+  }
+  /* Last block, which has less than "_rank" + 1 bits before it. */
+  while (low < high)
+  {
+    middle = low + (high - low + 1) / 2;
+    if (_bs->ranks[middle] <= _rank)
+    {
+      low = middle;
+    }
+    else
+    {
+      high = middle - 1;
+    }
+  }
+  _rank -= _bs->ranks[low];
+  word = low * NEDA_BITSET_RANK_WORDS;
+  while ((popcount = neda_bitset__popcount(_bs->words[word])) <= _rank)
+  {
+    _rank -= popcount;
+    word++;
+  }
+  bits = _bs->words[word];
+  while (_rank)
+  {
+    bits &= bits - 1;
+    _rank--;
+  }
+  return word * (nedasize_t)NEDA_BITSET_WORD_BITS + neda_bitset__lowest(bits);
+}
+
+
+#ifdef NEDA_PTHREAD
+#include <pthread.h>
+
+/* Arrays smaller than this are not split between threads. */
+#ifndef NEDA_PARALLEL_SORT_MIN_SIZE
+#define NEDA_PARALLEL_SORT_MIN_SIZE 16384
+#endif
+
+/* "parallel_sort" uses POSIX threads, so it is available only if
+ * NEDA_PTHREAD is defined. Array is split into "_threads_count" runs,
+ * which are sorted concurrently by "sort" engine, then runs are merged
+ * by pairs with each merge split between threads. Order is the same,
+ * as "sort" gives. Like "stable_sort", it always moves elements by
+ * assignment and "memcpy", swap and move functions are not used.
+ * Example:
+ *   #define NEDA_PTHREAD
+ *   #include <neda.h>
+ *   NEDA_HEADER(int)
+ *   NEDA_BODY_IMPLEMENTATION(int, 128)
+ *   NEDA_PARALLEL_HEADER(int)
+ *   NEDA_PARALLEL_BODY_IMPLEMENTATION(int)
+ */
+#define NEDA_PARALLEL_HEADER_POSTFIX(_postfix, _type) \
+  NEDA_DEF void neda_##_postfix##__parallel_sort(     \
+      struct neda_##_postfix *_da, const unsigned int _threads_count);
+
+#define NEDA_PARALLEL_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)         \
+  /* One sorting or merging job of "parallel_sort". */                     \
+  struct neda_##_postfix##__parallel_task                                  \
+  {                                                                        \
+    _type *first, *last;                                                   \
+    const _type *left, *right;                                             \
+    nedasize_t left_size, right_size;                                      \
+    nedasize_t output_begin, output_end;                                   \
+    _type *output;                                                         \
+    const struct neda_##_postfix##__functions *functions;                  \
+  };                                                                       \
+  NEDA_INTERNAL void *neda_##_postfix##__parallel_sort_thread(             \
+      void *_task)                                                         \
+  {                                                                        \
+    struct neda_##_postfix##__parallel_task *task =                        \
+        (struct neda_##_postfix##__parallel_task *)_task;                  \
+    neda_##_postfix##__sort_engine_range(                                  \
+        task->first,                                                       \
+        task->last,                                                        \
+        task->functions);                                                  \
+    return 0;                                                              \
+  }                                                                        \
+  /* \returns count of elements, which are taken from "_left" into         \
+     first "_output_index" elements of merged range. */                    \
+  NEDA_INTERNAL nedasize_t neda_##_postfix##__parallel_split(              \
+      const struct neda_##_postfix##__parallel_task *_task,                \
+      const nedasize_t _output_index)                                      \
+  {                                                                        \
+    NEDA_REGISTER nedasize_t low, high, middle;                            \
+    low = _output_index > _task->right_size                                \
+              ? _output_index - _task->right_size                          \
+              : 0;                                                         \
+    high = _output_index < _task->left_size                                \
+               ? _output_index                                             \
+               : _task->left_size;                                         \
+    while (low < high)                                                     \
+    {                                                                      \
+      middle = low + (high - low) / 2;                                     \
+      if (_output_index - middle > 0 &&                                    \
+          !neda_##_postfix##__less(                                        \
+              _task->functions,                                            \
+              &_task->right[_output_index - middle - 1],                   \
+              &_task->left[middle]))                                       \
+      {                                                                    \
+        low = middle + 1;                                                  \
+      }                                                                    \
+      else                                                                 \
+      {                                                                    \
+        high = middle;                                                     \
+      }                                                                    \
+    }                                                                      \
+    return low;                                                            \
+  }                                                                        \
+  /* Merges part [output_begin; output_end) of two sorted ranges. */       \
+  NEDA_INTERNAL void *neda_##_postfix##__parallel_merge_thread(            \
+      void *_task)                                                         \
+  {                                                                        \
+    struct neda_##_postfix##__parallel_task *task =                        \
+        (struct neda_##_postfix##__parallel_task *)_task;                  \
+    NEDA_REGISTER nedasize_t left_index, right_index;                      \
+    nedasize_t left_end, right_end;                                        \
+    _type *output = task->output + task->output_begin;                     \
+    left_index = neda_##_postfix##__parallel_split(                        \
+        task,                                                              \
+        task->output_begin);                                               \
+    right_index = task->output_begin - left_index;                         \
+    left_end = neda_##_postfix##__parallel_split(                          \
+        task,                                                              \
+        task->output_end);                                                 \
+    right_end = task->output_end - left_end;                               \
+    while (left_index < left_end && right_index < right_end)               \
+    {                                                                      \
+      if (neda_##_postfix##__less(                                         \
+              task->functions,                                             \
+              &task->right[right_index],                                   \
+              &task->left[left_index]))                                    \
+      {                                                                    \
+        *output++ = task->right[right_index++];                            \
+      }                                                                    \
+      else                                                                 \
+      {                                                                    \
+        *output++ = task->left[left_index++];                              \
+      }                                                                    \
+    }                                                                      \
+    while (left_index < left_end)                                          \
+    {                                                                      \
+      *output++ = task->left[left_index++];                                \
+    }                                                                      \
+    while (right_index < right_end)                                        \
+    {                                                                      \
+      *output++ = task->right[right_index++];                              \
+    }                                                                      \
+    return 0;                                                              \
+  }                                                                        \
+  /* Runs "_count" tasks in separate threads. If thread can not be         \
+     created, task is done by current thread. */                           \
+  NEDA_INTERNAL void neda_##_postfix##__parallel_run(                      \
+      struct neda_##_postfix##__parallel_task *_tasks,                     \
+      const nedasize_t _count,                                             \
+      void *(*_function)(void *),                                          \
+      pthread_t *_threads,                                                 \
+      int *_started)                                                       \
+  {                                                                        \
+    NEDA_REGISTER nedasize_t i = 1;                                        \
+    while (i < _count)                                                     \
+    {                                                                      \
+      _started[i] = pthread_create(                                        \
+                        &_threads[i],                                      \
+                        0,                                                 \
+                        _function,                                         \
+                        &_tasks[i]) == 0;                                  \
+      if (!_started[i])                                                    \
+      {                                                                    \
+        _function(&_tasks[i]);                                             \
+      }                                                                    \
+      i++;                                                                 \
+    }                                                                      \
+    if (_count)                                                            \
+    {                                                                      \
+      _function(&_tasks[0]);                                               \
+    }                                                                      \
+    i = 1;                                                                 \
+    while (i < _count)                                                     \
+    {                                                                      \
+      if (_started[i])                                                     \
+      {                                                                    \
+        pthread_join(_threads[i], 0);                                      \
+      }                                                                    \
+      i++;                                                                 \
+    }                                                                      \
+  }                                                                        \
+  NEDA_API void neda_##_postfix##__parallel_sort(                          \
+      struct neda_##_postfix *_da,                                         \
+      const unsigned int _threads_count)                                   \
+  {                                                                        \
+    struct neda_##_postfix##__parallel_task *tasks;                        \
+    nedasize_t *runs;                                                      \
+    pthread_t *threads;                                                    \
+    int *started;                                                          \
+    _type *source, *destination, *temp;                                    \
+    nedasize_t threads_count, runs_count, pairs, pieces;                   \
+    nedasize_t task_index, i, piece;                                       \
+    nedasize_t left_begin, right_begin, right_end;                         \
+    struct neda_##_postfix##__functions functions;                         \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                      \
+    runs_count = _threads_count ? _threads_count : 1;                      \
+    if (runs_count > _da->size / NEDA_PARALLEL_SORT_MIN_SIZE)              \
+    {                                                                      \
+      runs_count = _da->size / NEDA_PARALLEL_SORT_MIN_SIZE;                \
+    }                                                                      \
+    if (runs_count < 2)                                                    \
+    {                                                                      \
+      neda_##_postfix##__sort(_da);                                        \
+      return;                                                              \
+    }                                                                      \
+    threads_count = runs_count;                                            \
+    tasks = (struct neda_##_postfix##__parallel_task *)NEDA_MALLOC(        \
+        sizeof(struct neda_##_postfix##__parallel_task) * threads_count);  \
+    runs = (nedasize_t *)NEDA_MALLOC(                                      \
+        sizeof(nedasize_t) * (runs_count + 1));                            \
+    threads = (pthread_t *)NEDA_MALLOC(sizeof(pthread_t) * threads_count); \
+    started = (int *)NEDA_MALLOC(sizeof(int) * threads_count);             \
+    destination = (_type *)neda_allocate(                                  \
+        _da->allocator,                                                    \
+        sizeof(_type) * _da->size);                                        \
+    NEDA_ASSERT(tasks && runs && threads && started && destination);       \
+    source = _da->data;                                                    \
+    neda_##_postfix##__get_functions(_da, &functions);                     \
+    i = 0;                                                                 \
+    while (i < threads_count)                                              \
+    {                                                                      \
+      tasks[i].functions = &functions;                                     \
+      i++;                                                                 \
+    }                                                                      \
+    /* Every thread sorts it's own run. */                                 \
+    i = 0;                                                                 \
+    while (i < runs_count)                                                 \
+    {                                                                      \
+      runs[i] = _da->size / runs_count * i;                                \
+      tasks[i].first = source + runs[i];                                   \
+      tasks[i].last = source + (i + 1 == runs_count                        \
+                                    ? _da->size                            \
+                                    : _da->size / runs_count * (i + 1));   \
+      i++;                                                                 \
+    }                                                                      \
+    runs[runs_count] = _da->size;                                          \
+    neda_##_postfix##__parallel_run(                                       \
+        tasks,                                                             \
+        runs_count,                                                        \
+        neda_##_postfix##__parallel_sort_thread,                           \
+        threads,                                                           \
+        started);                                                          \
+    /* Pairs of runs are merged, until only one run left. Every merge      \
+       is split into pieces, so all threads are busy. */                   \
+    while (runs_count > 1)                                                 \
+    {                                                                      \
+      pairs = runs_count / 2;                                              \
+      pieces = threads_count / pairs;                                      \
+      if (pieces < 1)                                                      \
+      {                                                                    \
+        pieces = 1;                                                        \
+      }                                                                    \
+      task_index = 0;                                                      \
+      i = 0;                                                               \
+      while (i < pairs)                                                    \
+      {                                                                    \
+        left_begin = runs[i * 2];                                          \
+        right_begin = runs[i * 2 + 1];                                     \
+        right_end = runs[i * 2 + 2];                                       \
+        piece = 0;                                                         \
+        while (piece < pieces && task_index < threads_count)               \
+        {                                                                  \
+          tasks[task_index].left = source + left_begin;                    \
+          tasks[task_index].left_size = right_begin - left_begin;          \
+          tasks[task_index].right = source + right_begin;                  \
+          tasks[task_index].right_size = right_end - right_begin;          \
+          tasks[task_index].output = destination + left_begin;             \
+          tasks[task_index].output_begin =                                 \
+              (right_end - left_begin) / pieces * piece;                   \
+          tasks[task_index].output_end =                                   \
+              piece + 1 == pieces                                          \
+                  ? right_end - left_begin                                 \
+                  : (right_end - left_begin) / pieces * (piece + 1);       \
+          task_index++;                                                    \
+          piece++;                                                         \
+        }                                                                  \
+        runs[i + 1] = right_end;                                           \
+        i++;                                                               \
+      }                                                                    \
+      /* Last run without pair is just copied. */                          \
+      if (runs_count % 2)                                                  \
+      {                                                                    \
+        memcpy(                                                            \
+            destination + runs[runs_count - 1],                            \
+            source + runs[runs_count - 1],                                 \
+            sizeof(_type) * (_da->size - runs[runs_count - 1]));           \
+        runs[pairs + 1] = _da->size;                                       \
+        pairs++;                                                           \
+      }                                                                    \
+      neda_##_postfix##__parallel_run(                                     \
+          tasks,                                                           \
+          task_index,                                                      \
+          neda_##_postfix##__parallel_merge_thread,                        \
+          threads,                                                         \
+          started);                                                        \
+      runs_count = pairs;                                                  \
+      temp = source;                                                       \
+      source = destination;                                                \
+      destination = temp;                                                  \
+    }                                                                      \
+    if (source != _da->data)                                               \
+    {                                                                      \
+      memcpy(_da->data, source, sizeof(_type) * _da->size);                \
+      destination = source;                                                \
+    }                                                                      \
+    neda_deallocate(_da->allocator, destination);                          \
+    NEDA_FREE(started);                                                    \
+    NEDA_FREE(threads);                                                    \
+    NEDA_FREE(runs);                                                       \
+    NEDA_FREE(tasks);                                                      \
+  }
+
+#define NEDA_PARALLEL_HEADER(_type) NEDA_PARALLEL_HEADER_POSTFIX(_type, _type)
+#define NEDA_PARALLEL_BODY_IMPLEMENTATION(_type) NEDA_PARALLEL_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+#endif
+
+#ifdef NEDA_MMAP
+/* File-backed arrays, see "neda_mapping". Every function of array
+ * works with them, only "init_mapped" and "close_mapped" should be
+ * used instead of "init" and "free". Snapshots, which are written by
+ * "save", are mapped read-only by "open_mapped". Example:
+ *   #define _GNU_SOURCE
+ *   #define NEDA_MMAP
+ *   #include <neda.h>
+ *   NEDA_HEADER(int)
+ *   NEDA_BODY_IMPLEMENTATION_GROWTH(int, 128, NEDA_GROWTH_GEOMETRIC_2)
+ *   NEDA_MAPPED_HEADER(int)
+ *   NEDA_MAPPED_BODY_IMPLEMENTATION(int)
+ */
+#define NEDA_MAPPED_HEADER_POSTFIX(_postfix, _type)                                                         \
+  NEDA_DEF int neda_##_postfix##__init_mapped(                                                              \
+      struct neda_##_postfix *_da, struct neda_mapping *_mapping, const char *_path);                       \
+  NEDA_DEF int neda_##_postfix##__close_mapped(struct neda_##_postfix *_da, struct neda_mapping *_mapping); \
+  NEDA_DEF int neda_##_postfix##__open_mapped(                                                              \
+      struct neda_##_postfix *_da, struct neda_snapshot *_snapshot, const char *_path, const int _verify);  \
+  NEDA_DEF void neda_##_postfix##__close_snapshot(struct neda_##_postfix *_da, struct neda_snapshot *_snapshot);
+
+#define NEDA_MAPPED_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)           \
+  /* Opens file at "_path" as data of array, elements, which are in        \
+     file already, are in array. "_mapping" should live, until             \
+     "close_mapped" is called. */                                          \
+  NEDA_API int neda_##_postfix##__init_mapped(                             \
+      struct neda_##_postfix *_da,                                         \
+      struct neda_mapping *_mapping,                                       \
+      const char *_path)                                                   \
+  {                                                                        \
+    NEDA_ASSERT(_da);                                                      \
+    if (neda_mapping__open(_mapping, _path) != NEDA_SUCCESS)               \
+    {                                                                      \
+      return NEDA_FAILURE;                                                 \
+    }                                                                      \
+    neda_##_postfix##__init_in_place_allocator(_da, &_mapping->allocator); \
+    _da->data = (_type *)_mapping->address;                                \
+    _da->capacity = (nedasize_t)(_mapping->size / sizeof(_type));          \
+    _da->size = _da->capacity;                                             \
+    return NEDA_SUCCESS;                                                   \
+  }                                                                        \
+  /* Cuts file to size of array and closes it. Array is left empty,        \
+     like after "destroy". */                                              \
+  NEDA_API int neda_##_postfix##__close_mapped(                            \
+      struct neda_##_postfix *_da,                                         \
+      struct neda_mapping *_mapping)                                       \
+  {                                                                        \
+    int result;                                                            \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                      \
+    result = neda_mapping__close(                                          \
+        _mapping,                                                          \
+        sizeof(_type) * _da->size);                                        \
+    _da->data = 0;                                                         \
+    _da->capacity = 0;                                                     \
+    _da->size = 0;                                                         \
+    return result;                                                         \
+  }                                                                        \
+  /* Maps snapshot, which was written by "save", read-only: data of        \
+     array points into file, nothing is copied. Array should not be        \
+     changed, until "close_snapshot" is called. */                         \
+  NEDA_API int neda_##_postfix##__open_mapped(                             \
+      struct neda_##_postfix *_da,                                         \
+      struct neda_snapshot *_snapshot,                                     \
+      const char *_path,                                                   \
+      const int _verify)                                                   \
+  {                                                                        \
+    const struct neda_snapshot_header *header;                             \
+    NEDA_ASSERT(_da);                                                      \
+    neda_##_postfix##__init_in_place(_da);                                 \
+    if (neda_snapshot__open(_snapshot, _path, sizeof(_type), _verify) !=   \
+        NEDA_SUCCESS)                                                      \
+    {                                                                      \
+      return NEDA_FAILURE;                                                 \
+    }                                                                      \
+    header = (const struct neda_snapshot_header *)_snapshot->address;      \
+    _da->data = (_type *)(header + 1);                                     \
+    _da->capacity = (nedasize_t)header->count;                             \
+    _da->size = _da->capacity;                                             \
+    return NEDA_SUCCESS;                                                   \
+  }                                                                        \
+  NEDA_API void neda_##_postfix##__close_snapshot(                         \
+      struct neda_##_postfix *_da,                                         \
+      struct neda_snapshot *_snapshot)                                     \
+  {                                                                        \
+    NEDA_ASSERT(_da);                                                      \
+    neda_snapshot__close(_snapshot);                                       \
+    _da->data = 0;                                                         \
+    _da->capacity = 0;                                                     \
+    _da->size = 0;                                                         \
+  }
+
+#define NEDA_MAPPED_HEADER(_type) NEDA_MAPPED_HEADER_POSTFIX(_type, _type)
+#define NEDA_MAPPED_BODY_IMPLEMENTATION(_type) NEDA_MAPPED_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+#endif
+
+#ifdef NEDA_ATOMIC
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* Size of cache line. Indices, which are written by different threads,
+ * are kept in different lines, so threads do not invalidate each other
+ * caches (false sharing). */
+#ifndef NEDA_CACHE_LINE
+#define NEDA_CACHE_LINE 64
+#endif
+
+/* Bounded lock-free queues, they need C11 atomics and NEDA_ATOMIC.
+ * "neda_spsc_" queue is for one producer and one consumer thread: every
+ * index is written only by one thread, and other index is cached, so
+ * shared cache line is read only, when queue looks full or empty.
+ * "neda_mpmc_" queue is for any count of producers and consumers
+ * (by Dmitry Vyukov): every cell has sequence number, which tells, is
+ * cell free for push or filled for pop, so threads claim cells by one
+ * compare-and-swap of index. Both queues never block: "try_push" fails
+ * on full queue and "try_pop" fails on empty one. Example:
+ *   #define NEDA_ATOMIC
+ *   #include <neda.h>
+ *   NEDA_SPSC_HEADER(int)
+ *   NEDA_SPSC_BODY_IMPLEMENTATION(int)
+ *   ...
+ *   struct neda_spsc_int *queue;
+ *   neda_spsc_int__init(&queue, 1024);
+ *   while (!neda_spsc_int__try_push(queue, 1))
+ *     ;
+ */
+#define NEDA_SPSC_HEADER_POSTFIX(_postfix, _type)                                                               \
+  typedef struct neda_spsc_##_postfix                                                                           \
+  {                                                                                                             \
+    /* Written by producer. */                                                                                  \
+    atomic_size_t tail;                                                                                         \
+    size_t cached_head;                                                                                         \
+    char tail_padding[NEDA_CACHE_LINE - 2 * sizeof(size_t)];                                                    \
+    /* Written by consumer. */                                                                                  \
+    atomic_size_t head;                                                                                         \
+    size_t cached_tail;                                                                                         \
+    char head_padding[NEDA_CACHE_LINE - 2 * sizeof(size_t)];                                                    \
+    _type *data;                                                                                                \
+    nedasize_t capacity;                                                                                        \
+  } neda_spsc_##_postfix;                                                                                       \
+  NEDA_DEF void neda_spsc_##_postfix##__init(struct neda_spsc_##_postfix **_queue, const nedasize_t _capacity); \
+  NEDA_DEF int neda_spsc_##_postfix##__try_push(struct neda_spsc_##_postfix *_queue, const _type _value);       \
+  NEDA_DEF int neda_spsc_##_postfix##__try_pop(struct neda_spsc_##_postfix *_queue, _type *_value);             \
+  NEDA_DEF nedasize_t neda_spsc_##_postfix##__size(struct neda_spsc_##_postfix *_queue);                        \
+  NEDA_DEF nedasize_t neda_spsc_##_postfix##__capacity(struct neda_spsc_##_postfix *_queue);                    \
+  NEDA_DEF void neda_spsc_##_postfix##__free(struct neda_spsc_##_postfix **_queue);
+
+#define NEDA_SPSC_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)            \
+  /* Capacity is rounded up to power of two. If it does not fit,          \
+     "*_queue" is set to NULL. */                                         \
+  NEDA_API void neda_spsc_##_postfix##__init(                             \
+      struct neda_spsc_##_postfix **_queue,                               \
+      const nedasize_t _capacity)                                         \
+  {                                                                       \
+    nedasize_t capacity = 2;                                              \
+    while (capacity < _capacity)                                          \
+    {                                                                     \
+      /* Doubling would wrap to zero and never reach "_capacity". */      \
+      if (capacity > (nedasize_t)-1 / 2)                                  \
+      {                                                                   \
+        NEDA_ASSERT(0);                                                   \
+        *_queue = NULL;                                                   \
+        return;                                                           \
+      }                                                                   \
+      capacity <<= 1;                                                     \
+    }                                                                     \
+    if (sizeof(_type) * capacity / sizeof(_type) != capacity)             \
+    {                                                                     \
+      NEDA_ASSERT(0);                                                     \
+      *_queue = NULL;                                                     \
+      return;                                                             \
+    }                                                                     \
+    *_queue = (struct neda_spsc_##_postfix *)NEDA_MALLOC(                 \
+        sizeof(struct neda_spsc_##_postfix));                             \
+    NEDA_ASSERT(*_queue);                                                 \
+    (*_queue)->data = (_type *)NEDA_MALLOC(sizeof(_type) * capacity);     \
+    NEDA_ASSERT((*_queue)->data);                                         \
+    (*_queue)->capacity = capacity;                                       \
+    atomic_init(&(*_queue)->tail, 0);                                     \
+    atomic_init(&(*_queue)->head, 0);                                     \
+    (*_queue)->cached_head = 0;                                           \
+    (*_queue)->cached_tail = 0;                                           \
+  }                                                                       \
+  /* Should be called only by producer thread.                            \
+     \returns 1, if value was pushed, or 0, if queue is full. */          \
+  NEDA_API int neda_spsc_##_postfix##__try_push(                          \
+      struct neda_spsc_##_postfix *_queue,                                \
+      const _type _value)                                                 \
+  {                                                                       \
+    size_t tail;                                                          \
+    NEDA_ASSERT(_queue);                                                  \
+    tail = atomic_load_explicit(&_queue->tail, memory_order_relaxed);     \
+    /* Head is loaded from shared line only, when cached one says,        \
+       that queue is full. */                                             \
+    if (tail - _queue->cached_head == _queue->capacity)                   \
+    {                                                                     \
+      _queue->cached_head = atomic_load_explicit(                         \
+          &_queue->head,                                                  \
+          memory_order_acquire);                                          \
+      if (tail - _queue->cached_head == _queue->capacity)                 \
+      {                                                                   \
+        return 0;                                                         \
+      }                                                                   \
+    }                                                                     \
+    _queue->data[tail & (_queue->capacity - 1)] = _value;                 \
+    atomic_store_explicit(&_queue->tail, tail + 1, memory_order_release); \
+    return 1;                                                             \
+  }                                                                       \
+  /* Should be called only by consumer thread.                            \
+     \returns 1, if value was popped into "_value", or 0, if queue is     \
+     empty. */                                                            \
+  NEDA_API int neda_spsc_##_postfix##__try_pop(                           \
+      struct neda_spsc_##_postfix *_queue,                                \
+      _type *_value)                                                      \
+  {                                                                       \
+    size_t head;                                                          \
+    NEDA_ASSERT(_queue && _value);                                        \
+    head = atomic_load_explicit(&_queue->head, memory_order_relaxed);     \
+    if (head == _queue->cached_tail)                                      \
+    {                                                                     \
+      _queue->cached_tail = atomic_load_explicit(                         \
+          &_queue->tail,                                                  \
+          memory_order_acquire);                                          \
+      if (head == _queue->cached_tail)                                    \
+      {                                                                   \
+        return 0;                                                         \
+      }                                                                   \
+    }                                                                     \
+    *_value = _queue->data[head & (_queue->capacity - 1)];                \
+    atomic_store_explicit(&_queue->head, head + 1, memory_order_release); \
+    return 1;                                                             \
+  }                                                                       \
+  /* \returns count of elements. It can be outdated, if other thread      \
+     works with queue. */                                                 \
+  NEDA_API nedasize_t neda_spsc_##_postfix##__size(                       \
+      struct neda_spsc_##_postfix *_queue)                                \
+  {                                                                       \
+    size_t head, tail;                                                    \
+    NEDA_ASSERT(_queue);                                                  \
+    head = atomic_load_explicit(&_queue->head, memory_order_acquire);     \
+    tail = atomic_load_explicit(&_queue->tail, memory_order_acquire);     \
+    return (nedasize_t)(tail - head);                                     \
+  }                                                                       \
+  NEDA_API nedasize_t neda_spsc_##_postfix##__capacity(                   \
+      struct neda_spsc_##_postfix *_queue)                                \
+  {                                                                       \
+    NEDA_ASSERT(_queue);                                                  \
+    return _queue->capacity;                                              \
+  }                                                                       \
+  NEDA_API void neda_spsc_##_postfix##__free(                             \
+      struct neda_spsc_##_postfix **_queue)                               \
+  {                                                                       \
+    NEDA_ASSERT(_queue && *_queue);                                       \
+    NEDA_FREE((*_queue)->data);                                           \
+    NEDA_FREE(*_queue);                                                   \
+    *_queue = 0;                                                          \
+  }
+
+#define NEDA_SPSC_HEADER(_type) NEDA_SPSC_HEADER_POSTFIX(_type, _type)
+#define NEDA_SPSC_BODY_IMPLEMENTATION(_type) NEDA_SPSC_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+
+#define NEDA_MPMC_HEADER_POSTFIX(_postfix, _type)                                                               \
+  struct neda_mpmc_##_postfix##__cell                                                                           \
+  {                                                                                                             \
+    atomic_size_t sequence;                                                                                     \
+    _type value;                                                                                                \
+  };                                                                                                            \
+  typedef struct neda_mpmc_##_postfix                                                                           \
+  {                                                                                                             \
+    atomic_size_t tail;                                                                                         \
+    char tail_padding[NEDA_CACHE_LINE - sizeof(size_t)];                                                        \
+    atomic_size_t head;                                                                                         \
+    char head_padding[NEDA_CACHE_LINE - sizeof(size_t)];                                                        \
+    struct neda_mpmc_##_postfix##__cell *cells;                                                                 \
+    nedasize_t capacity;                                                                                        \
+  } neda_mpmc_##_postfix;                                                                                       \
+  NEDA_DEF void neda_mpmc_##_postfix##__init(struct neda_mpmc_##_postfix **_queue, const nedasize_t _capacity); \
+  NEDA_DEF int neda_mpmc_##_postfix##__try_push(struct neda_mpmc_##_postfix *_queue, const _type _value);       \
+  NEDA_DEF int neda_mpmc_##_postfix##__try_pop(struct neda_mpmc_##_postfix *_queue, _type *_value);             \
+  NEDA_DEF nedasize_t neda_mpmc_##_postfix##__size(struct neda_mpmc_##_postfix *_queue);                        \
+  NEDA_DEF nedasize_t neda_mpmc_##_postfix##__capacity(struct neda_mpmc_##_postfix *_queue);                    \
+  NEDA_DEF void neda_mpmc_##_postfix##__free(struct neda_mpmc_##_postfix **_queue);
+
+#define NEDA_MPMC_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)             \
+  /* Capacity is rounded up to power of two. If it does not fit,           \
+     "*_queue" is set to NULL. */                                          \
+  NEDA_API void neda_mpmc_##_postfix##__init(                              \
+      struct neda_mpmc_##_postfix **_queue,                                \
+      const nedasize_t _capacity)                                          \
+  {                                                                        \
+    nedasize_t capacity = 2, i = 0;                                        \
+    while (capacity < _capacity)                                           \
+    {                                                                      \
+      /* Doubling would wrap to zero and never reach "_capacity". */       \
+      if (capacity > (nedasize_t)-1 / 2)                                   \
+      {                                                                    \
+        NEDA_ASSERT(0);                                                    \
+        *_queue = NULL;                                                    \
+        return;                                                            \
+      }                                                                    \
+      capacity <<= 1;                                                      \
+    }                                                                      \
+    if (sizeof(struct neda_mpmc_##_postfix##__cell) * capacity /           \
+            sizeof(struct neda_mpmc_##_postfix##__cell) !=                 \
+        capacity)                                                          \
+    {                                                                      \
+      NEDA_ASSERT(0);                                                      \
+      *_queue = NULL;                                                      \
+      return;                                                              \
+    }                                                                      \
+    *_queue = (struct neda_mpmc_##_postfix *)NEDA_MALLOC(                  \
+        sizeof(struct neda_mpmc_##_postfix));                              \
+    NEDA_ASSERT(*_queue);                                                  \
+    (*_queue)->cells = (struct neda_mpmc_##_postfix##__cell *)NEDA_MALLOC( \
+        sizeof(struct neda_mpmc_##_postfix##__cell) * capacity);           \
+    NEDA_ASSERT((*_queue)->cells);                                         \
+    (*_queue)->capacity = capacity;                                        \
+    /* Cell is free for push number "sequence". */                         \
+    while (i < capacity)                                                   \
+    {                                                                      \
+      atomic_init(&(*_queue)->cells[i].sequence, i);                       \
+      i++;                                                                 \
+    }                                                                      \
+    atomic_init(&(*_queue)->tail, 0);                                      \
+    atomic_init(&(*_queue)->head, 0);                                      \
+  }                                                                        \
+  /* Can be called by any thread.                                          \
+     \returns 1, if value was pushed, or 0, if queue is full. */           \
+  NEDA_API int neda_mpmc_##_postfix##__try_push(                           \
+      struct neda_mpmc_##_postfix *_queue,                                 \
+      const _type _value)                                                  \
+  {                                                                        \
+    struct neda_mpmc_##_postfix##__cell *cell;                             \
+    size_t position, sequence;                                             \
+    NEDA_ASSERT(_queue);                                                   \
+    position = atomic_load_explicit(&_queue->tail, memory_order_relaxed);  \
+    while (1)                                                              \
+    {                                                                      \
+      cell = &_queue->cells[position & (_queue->capacity - 1)];            \
+      sequence = atomic_load_explicit(                                     \
+          &cell->sequence,                                                 \
+          memory_order_acquire);                                           \
+      if (sequence == position)                                            \
+      {                                                                    \
+        /* Cell is free, it is taken, if tail was not moved. */            \
+        if (atomic_compare_exchange_weak_explicit(                         \
+                &_queue->tail,                                             \
+                &position,                                                 \
+                position + 1,                                              \
+                memory_order_relaxed,                                      \
+                memory_order_relaxed))                                     \
+        {                                                                  \
+          break;                                                           \
+        }                                                                  \
+      }                                                                    \
+      else if ((ptrdiff_t)(sequence - position) < 0)                       \
+      {                                                                    \
+        /* Cell still keeps value from previous lap. */                    \
+        return 0;                                                          \
+      }                                                                    \
+      else                                                                 \
+      {                                                                    \
+        position = atomic_load_explicit(                                   \
+            &_queue->tail,                                                 \
+            memory_order_relaxed);                                         \
+      }                                                                    \
+    }                                                                      \
+    cell->value = _value;                                                  \
+    atomic_store_explicit(                                                 \
+        &cell->sequence,                                                   \
+        position + 1,                                                      \
+        memory_order_release);                                             \
+    return 1;                                                              \
+  }                                                                        \
+  /* Can be called by any thread.                                          \
+     \returns 1, if value was popped into "_value", or 0, if queue is      \
+     empty. */                                                             \
+  NEDA_API int neda_mpmc_##_postfix##__try_pop(                            \
+      struct neda_mpmc_##_postfix *_queue,                                 \
+      _type *_value)                                                       \
+  {                                                                        \
+    struct neda_mpmc_##_postfix##__cell *cell;                             \
+    size_t position, sequence;                                             \
+    NEDA_ASSERT(_queue && _value);                                         \
+    position = atomic_load_explicit(&_queue->head, memory_order_relaxed);  \
+    while (1)                                                              \
+    {                                                                      \
+      cell = &_queue->cells[position & (_queue->capacity - 1)];            \
+      sequence = atomic_load_explicit(                                     \
+          &cell->sequence,                                                 \
+          memory_order_acquire);                                           \
+      if (sequence == position + 1)                                        \
+      {                                                                    \
+        if (atomic_compare_exchange_weak_explicit(                         \
+                &_queue->head,                                             \
+                &position,                                                 \
+                position + 1,                                              \
+                memory_order_relaxed,                                      \
+                memory_order_relaxed))                                     \
+        {                                                                  \
+          break;                                                           \
+        }                                                                  \
+      }                                                                    \
+      else if ((ptrdiff_t)(sequence - (position + 1)) < 0)                 \
+      {                                                                    \
+        /* Cell was not written yet. */                                    \
+        return 0;                                                          \
+      }                                                                    \
+      else                                                                 \
+      {                                                                    \
+        position = atomic_load_explicit(                                   \
+            &_queue->head,                                                 \
+            memory_order_relaxed);                                         \
+      }                                                                    \
+    }                                                                      \
+    *_value = cell->value;                                                 \
+    /* Cell becomes free for push of the next lap. */                      \
+    atomic_store_explicit(                                                 \
+        &cell->sequence,                                                   \
+        position + _queue->capacity,                                       \
+        memory_order_release);                                             \
+    return 1;                                                              \
+  }                                                                        \
+  /* \returns count of elements. It can be outdated, if other threads      \
+     work with queue. */                                                   \
+  NEDA_API nedasize_t neda_mpmc_##_postfix##__size(                        \
+      struct neda_mpmc_##_postfix *_queue)                                 \
+  {                                                                        \
+    size_t head, tail;                                                     \
+    NEDA_ASSERT(_queue);                                                   \
+    head = atomic_load_explicit(&_queue->head, memory_order_acquire);      \
+    tail = atomic_load_explicit(&_queue->tail, memory_order_acquire);      \
+    return tail > head ? (nedasize_t)(tail - head) : 0;                    \
+  }                                                                        \
+  NEDA_API nedasize_t neda_mpmc_##_postfix##__capacity(                    \
+      struct neda_mpmc_##_postfix *_queue)                                 \
+  {                                                                        \
+    NEDA_ASSERT(_queue);                                                   \
+    return _queue->capacity;                                               \
+  }                                                                        \
+  NEDA_API void neda_mpmc_##_postfix##__free(                              \
+      struct neda_mpmc_##_postfix **_queue)                                \
+  {                                                                        \
+    NEDA_ASSERT(_queue && *_queue);                                        \
+    NEDA_FREE((*_queue)->cells);                                           \
+    NEDA_FREE(*_queue);                                                    \
+    *_queue = 0;                                                           \
+  }
+
+#define NEDA_MPMC_HEADER(_type) NEDA_MPMC_HEADER_POSTFIX(_type, _type)
+#define NEDA_MPMC_BODY_IMPLEMENTATION(_type) NEDA_MPMC_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+
+/* Size of the first segment of "neda_segmented_" array, next segments
+ * are twice bigger than previous. Should be power of two. */
+#ifndef NEDA_SEGMENTED_FIRST_SIZE
+#define NEDA_SEGMENTED_FIRST_SIZE 64
+#endif
+
+/* Count of segments, it limits size of array to
+ * NEDA_SEGMENTED_FIRST_SIZE * (2^NEDA_SEGMENTED_SEGMENTS - 1) elements. */
+#ifndef NEDA_SEGMENTED_SEGMENTS
+#define NEDA_SEGMENTED_SEGMENTS 40
+#endif
+
+/* \returns segment of element "_index" and writes offset of element in
+ * segment into "_offset". */
+NEDA_COMMON unsigned int neda_segmented__segment(
+    const size_t _index,
+    size_t *_offset)
+{
+  const size_t biased = _index / NEDA_SEGMENTED_FIRST_SIZE + 1;
+  unsigned int segment = 0;
+#if defined(__GNUC__) || defined(__clang__)
+  segment = (unsigned int)(sizeof(unsigned long) * 8 - 1) -
+            (unsigned int)__builtin_clzl((unsigned long)biased);
+#else
+  while (biased >> (segment + 1))
+  {
+    segment++;
+  }
+#endif
+  *_offset = _index -
+             (((size_t)1 << segment) - 1) * NEDA_SEGMENTED_FIRST_SIZE;
+  return segment;
+}
+
+/* Append-only array for many writer threads. Elements are kept in
+ * segments, which are never moved, so pointers from "at_ptr" stay
+ * valid, while other threads push. "push_back" reserves slot by one
+ * atomic increment and does not lock. Elements are read, when writers
+ * are finished, or by index, which was returned by "push_back".
+ * "flatten" copies elements into regular neda, for example to sort
+ * them, so regular neda of the same type should be generated too.
+ * Example:
+ *   #define NEDA_ATOMIC
+ *   #include <neda.h>
+ *   NEDA_HEADER(int)
+ *   NEDA_BODY_IMPLEMENTATION(int, 128)
+ *   NEDA_SEGMENTED_HEADER(int)
+ *   NEDA_SEGMENTED_BODY_IMPLEMENTATION(int)
+ *   ...
+ *   neda_segmented_int__push_back(results, 42);   (in every thread)
+ *   ...
+ *   neda_segmented_int__flatten(results, da);     (after join)
+ */
+#define NEDA_SEGMENTED_HEADER_POSTFIX(_postfix, _type)                                                                    \
+  typedef struct neda_segmented_##_postfix                                                                                \
+  {                                                                                                                       \
+    atomic_size_t size;                                                                                                   \
+    char size_padding[NEDA_CACHE_LINE - sizeof(size_t)];                                                                  \
+    _Atomic(_type *) segments[NEDA_SEGMENTED_SEGMENTS];                                                                   \
+  } neda_segmented_##_postfix;                                                                                            \
+  NEDA_DEF void neda_segmented_##_postfix##__init(struct neda_segmented_##_postfix **_sa);                                \
+  NEDA_DEF nedasize_t neda_segmented_##_postfix##__push_back(struct neda_segmented_##_postfix *_sa, const _type _value);  \
+  NEDA_DEF nedasize_t neda_segmented_##_postfix##__size(struct neda_segmented_##_postfix *_sa);                           \
+  NEDA_DEF _type neda_segmented_##_postfix##__at(struct neda_segmented_##_postfix *_sa, const nedasize_t _index);         \
+  NEDA_DEF _type *neda_segmented_##_postfix##__at_ptr(struct neda_segmented_##_postfix *_sa, const nedasize_t _index);    \
+  NEDA_DEF void neda_segmented_##_postfix##__flatten(struct neda_segmented_##_postfix *_sa, struct neda_##_postfix *_da); \
+  NEDA_DEF void neda_segmented_##_postfix##__clear(struct neda_segmented_##_postfix *_sa);                                \
+  NEDA_DEF void neda_segmented_##_postfix##__free(struct neda_segmented_##_postfix **_sa);
+
+#define NEDA_SEGMENTED_BODY_IMPLEMENTATION_POSTFIX(_postfix, _type)        \
+  NEDA_API void neda_segmented_##_postfix##__init(                         \
+      struct neda_segmented_##_postfix **_sa)                              \
+  {                                                                        \
+    unsigned int i = 0;                                                    \
+    *_sa = (struct neda_segmented_##_postfix *)NEDA_MALLOC(                \
+        sizeof(struct neda_segmented_##_postfix));                         \
+    NEDA_ASSERT(*_sa);                                                     \
+    atomic_init(&(*_sa)->size, 0);                                         \
+    while (i < NEDA_SEGMENTED_SEGMENTS)                                    \
+    {                                                                      \
+      atomic_init(&(*_sa)->segments[i], 0);                                \
+      i++;                                                                 \
+    }                                                                      \
+  }                                                                        \
+  /* Can be called by any thread. Slot is reserved by one atomic           \
+     increment, segment is allocated by thread, which needs it first.      \
+     \returns index of pushed element. */                                  \
+  NEDA_API nedasize_t neda_segmented_##_postfix##__push_back(              \
+      struct neda_segmented_##_postfix *_sa,                               \
+      const _type _value)                                                  \
+  {                                                                        \
+    size_t index, offset;                                                  \
+    unsigned int segment;                                                  \
+    _type *data, *allocated;                                               \
+    NEDA_ASSERT(_sa);                                                      \
+    index = atomic_fetch_add_explicit(                                     \
+        &_sa->size,                                                        \
+        1,                                                                 \
+        memory_order_relaxed);                                             \
+    segment = neda_segmented__segment(index, &offset);                     \
+    NEDA_ASSERT(segment < NEDA_SEGMENTED_SEGMENTS);                        \
+    data = atomic_load_explicit(                                           \
+        &_sa->segments[segment],                                           \
+        memory_order_acquire);                                             \
+    if (!data)                                                             \
+    {                                                                      \
+      allocated = (_type *)NEDA_MALLOC(                                    \
+          sizeof(_type) * ((size_t)NEDA_SEGMENTED_FIRST_SIZE << segment)); \
+      NEDA_ASSERT(allocated);                                              \
+      /* Thread, which lost the race, uses segment of winner. */           \
+      if (atomic_compare_exchange_strong_explicit(                         \
+              &_sa->segments[segment],                                     \
+              &data,                                                       \
+              allocated,                                                   \
+              memory_order_acq_rel,                                        \
+              memory_order_acquire))                                       \
+      {                                                                    \
+        data = allocated;                                                  \
+      }                                                                    \
+      else                                                                 \
+      {                                                                    \
+        NEDA_FREE(allocated);                                              \
+      }                                                                    \
+    }                                                                      \
+    data[offset] = _value;                                                 \
+    return (nedasize_t)index;                                              \
+  }                                                                        \
+  /* \returns count of pushed elements. Some of them can be still          \
+     written by other threads. */                                          \
+  NEDA_API nedasize_t neda_segmented_##_postfix##__size(                   \
+      struct neda_segmented_##_postfix *_sa)                               \
+  {                                                                        \
+    NEDA_ASSERT(_sa);                                                      \
+    return (nedasize_t)atomic_load_explicit(                               \
+        &_sa->size,                                                        \
+        memory_order_acquire);                                             \
+  }                                                                        \
+  NEDA_API _type neda_segmented_##_postfix##__at(                          \
+      struct neda_segmented_##_postfix *_sa,                               \
+      const nedasize_t _index)                                             \
+  {                                                                        \
+    return *neda_segmented_##_postfix##__at_ptr(_sa, _index);              \
+  }                                                                        \
+  /* \returns pointer to element, it is valid until "clear" or "free".     \
+     Element should be pushed and written already. */                      \
+  NEDA_API _type *neda_segmented_##_postfix##__at_ptr(                     \
+      struct neda_segmented_##_postfix *_sa,                               \
+      const nedasize_t _index)                                             \
+  {                                                                        \
+    size_t offset;                                                         \
+    unsigned int segment;                                                  \
+    NEDA_ASSERT(_sa);                                                      \
+    NEDA_ASSERT(_index < neda_segmented_##_postfix##__size(_sa));          \
+    segment = neda_segmented__segment(_index, &offset);                    \
+    return atomic_load_explicit(                                           \
+               &_sa->segments[segment],                                    \
+               memory_order_acquire) +                                     \
+           offset;                                                         \
+  }                                                                        \
+  /* Appends all elements to regular array "_da" in index order.           \
+     Should be called, when all pushing threads are finished. */           \
+  NEDA_API void neda_segmented_##_postfix##__flatten(                      \
+      struct neda_segmented_##_postfix *_sa,                               \
+      struct neda_##_postfix *_da)                                         \
+  {                                                                        \
+    size_t size, segment_size, count;                                      \
+    unsigned int segment = 0;                                              \
+    NEDA_ASSERT(_sa);                                                      \
+    NEDA_ASSERT(!NEDA_VALIDATE(_da));                                      \
+    size = atomic_load_explicit(&_sa->size, memory_order_acquire);         \
+    neda_##_postfix##__reserve(_da, _da->size + (nedasize_t)size);         \
+    segment_size = NEDA_SEGMENTED_FIRST_SIZE;                              \
+    while (size)                                                           \
+    {                                                                      \
+      count = size < segment_size ? size : segment_size;                   \
+      neda_##_postfix##__append_n(                                         \
+          _da,                                                             \
+          atomic_load_explicit(                                            \
+              &_sa->segments[segment],                                     \
+              memory_order_acquire),                                       \
+          (nedasize_t)count);                                              \
+      size -= count;                                                       \
+      segment_size <<= 1;                                                  \
+      segment++;                                                           \
+    }                                                                      \
+  }                                                                        \
+  /* Removes all elements, segments are kept for next pushes. Should       \
+     not be called concurrently with other functions. */                   \
+  NEDA_API void neda_segmented_##_postfix##__clear(                        \
+      struct neda_segmented_##_postfix *_sa)                               \
+  {                                                                        \
+    NEDA_ASSERT(_sa);                                                      \
+    atomic_store_explicit(&_sa->size, 0, memory_order_release);            \
+  }                                                                        \
+  NEDA_API void neda_segmented_##_postfix##__free(                         \
+      struct neda_segmented_##_postfix **_sa)                              \
+  {                                                                        \
+    unsigned int i = 0;                                                    \
+    NEDA_ASSERT(_sa && *_sa);                                              \
+    while (i < NEDA_SEGMENTED_SEGMENTS)                                    \
+    {                                                                      \
+      NEDA_FREE(atomic_load_explicit(                                      \
+          &(*_sa)->segments[i],                                            \
+          memory_order_relaxed));                                          \
+      i++;                                                                 \
+    }                                                                      \
+    NEDA_FREE(*_sa);                                                       \
+    *_sa = 0;                                                              \
+  }
+
+#define NEDA_SEGMENTED_HEADER(_type) NEDA_SEGMENTED_HEADER_POSTFIX(_type, _type)
+#define NEDA_SEGMENTED_BODY_IMPLEMENTATION(_type) NEDA_SEGMENTED_BODY_IMPLEMENTATION_POSTFIX(_type, _type)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
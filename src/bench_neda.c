@@ -0,0 +1,1267 @@
+#define _GNU_SOURCE
+#define NDEBUG
+#define NEDA_SIMD
+#define NEDA_MMAP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Counts reallocations, which "reserve" does. */
+static unsigned long bench_realloc_count = 0;
+static void *bench_realloc(void *_memory, size_t _new_size)
+{
+  bench_realloc_count++;
+  return realloc(_memory, _new_size);
+}
+#define NEDA_REALLOC(_memory, _new_size) bench_realloc(_memory, _new_size)
+
+#include "../include/neda.h"
+
+#define TAB "  " /* two spaces */
+#define BENCH_CHUNK 128
+#define BENCH_MAX_ELEMENTS (1 << 24)
+#define BENCH_SHIFT_ELEMENTS (1 << 20)
+#define BENCH_SHIFT_OPERATIONS 256
+#define BENCH_SORT_ELEMENTS (1 << 22)
+#define BENCH_REMOVE_ELEMENTS (1 << 16)
+#define BENCH_QUEUE_ELEMENTS (1 << 16)
+#define BENCH_QUEUE_OPERATIONS (1 << 22)
+#define BENCH_SMALL_ARRAYS (1 << 20)
+#define BENCH_SMALL_ELEMENTS 5
+#define BENCH_REQUESTS 4096
+#define BENCH_REQUEST_ARRAYS 64
+#define BENCH_REQUEST_ELEMENTS 100
+#define BENCH_TOP_K 100
+#define BENCH_SEARCH_ELEMENTS (1 << 22)
+#define BENCH_SEARCH_QUERIES (1 << 20)
+#define BENCH_LINEAR_QUERIES 256
+#define BENCH_HEAP_ELEMENTS (1 << 20)
+#define BENCH_BITS (1 << 26)
+#define BENCH_BIT_QUERIES (1 << 20)
+#define BENCH_RECORDS (1 << 20)
+#define BENCH_RECORD_SCANS 16
+#define BENCH_KERNEL_BYTES (1 << 26)
+#define BENCH_KERNEL_REPEATS 8
+
+NEDA_HEADER_POSTFIX(int_chunk, int)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(int_chunk, int, BENCH_CHUNK, NEDA_GROWTH_CHUNK)
+NEDA_HEADER_POSTFIX(int_geometric_1_5, int)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(int_geometric_1_5, int, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_1_5)
+NEDA_HEADER_POSTFIX(int_geometric_2, int)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(int_geometric_2, int, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_RADIX_HEADER_POSTFIX(int_geometric_2, int)
+NEDA_HEADER_POSTFIX(int_cmp, int)
+NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(int_cmp, int, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2, *_a < *_b)
+NEDA_RADIX_BODY_IMPLEMENTATION_POSTFIX(int_geometric_2, int, NEDA_RADIX_SIGNED)
+NEDA_DEQUE_HEADER(int)
+NEDA_DEQUE_BODY_IMPLEMENTATION(int)
+NEDA_SMALL_HEADER(int, 8)
+NEDA_SMALL_BODY_IMPLEMENTATION(int)
+NEDA_NUMERIC_HEADER_POSTFIX(int_geometric_2, int, long)
+NEDA_NUMERIC_BODY_IMPLEMENTATION_POSTFIX(int_geometric_2, int, long)
+NEDA_SNAPSHOT_HEADER_POSTFIX(int_geometric_2, int)
+NEDA_SNAPSHOT_BODY_IMPLEMENTATION_POSTFIX(int_geometric_2, int)
+NEDA_MAPPED_HEADER_POSTFIX(int_geometric_2, int)
+NEDA_MAPPED_BODY_IMPLEMENTATION_POSTFIX(int_geometric_2, int)
+NEDA_HEADER(float)
+NEDA_BODY_IMPLEMENTATION_GROWTH(float, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_NUMERIC_HEADER(float, float)
+NEDA_NUMERIC_BODY_IMPLEMENTATION(float, float)
+NEDA_HEADER(double)
+NEDA_BODY_IMPLEMENTATION_GROWTH(double, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_NUMERIC_HEADER(double, double)
+NEDA_NUMERIC_BODY_IMPLEMENTATION(double, double)
+NEDA_HEADER(char)
+NEDA_BODY_IMPLEMENTATION_GROWTH(char, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_HEADER_POSTFIX(int_heap_2, int)
+NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(int_heap_2, int, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2, *_a < *_b)
+NEDA_HEAP_HEADER_POSTFIX(int_heap_2, int)
+NEDA_HEAP_BODY_IMPLEMENTATION_POSTFIX(int_heap_2, int)
+NEDA_HEADER_POSTFIX(int_heap_4, int)
+NEDA_BODY_IMPLEMENTATION_CMP_GROWTH_POSTFIX(int_heap_4, int, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2, *_a < *_b)
+NEDA_HEAP_HEADER_POSTFIX(int_heap_4, int)
+NEDA_HEAP_BODY_IMPLEMENTATION_ARITY_POSTFIX(int_heap_4, int, 4)
+
+/* Record of 64 bytes, only "price" is scanned. */
+struct bench_record
+{
+  double price;
+  double quantity;
+  long id;
+  long timestamp;
+  char payload[32];
+};
+NEDA_HEADER_POSTFIX(record, struct bench_record)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(record, struct bench_record, BENCH_CHUNK, NEDA_GROWTH_GEOMETRIC_2)
+#define BENCH_RECORD_FIELDS(_field, _argument) \
+  _field(_argument, double, price)             \
+  _field(_argument, double, quantity)          \
+  _field(_argument, long, id)                  \
+  _field(_argument, long, timestamp)
+NEDA_SOA_HEADER(record, BENCH_RECORD_FIELDS)
+NEDA_SOA_BODY_IMPLEMENTATION(record, BENCH_RECORD_FIELDS)
+
+static double bench_seconds(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static void bench_print(
+    const char *_name,
+    const unsigned long _elements,
+    const double _seconds)
+{
+  printf(
+      TAB "%-28s %9lu elements: %8.3f ms; %7.3f ns/element; reallocs: %lu;\n",
+      _name,
+      _elements,
+      _seconds * 1e3,
+      _seconds * 1e9 / (double)_elements,
+      bench_realloc_count);
+}
+
+/* "push_back" without up-front "reserve". Amortized O(1) append
+ * should give almost the same ns/element for every array size.
+ */
+#define BENCH_PUSH_BACK(_postfix)                 \
+  static void bench_push_back_##_postfix(void)    \
+  {                                               \
+    struct neda_##_postfix *da;                   \
+    unsigned long elements = 1 << 20;             \
+    unsigned long i;                              \
+    double begin;                                 \
+    while (elements <= BENCH_MAX_ELEMENTS)        \
+    {                                             \
+      neda_##_postfix##__init(&da);               \
+      bench_realloc_count = 0;                    \
+      begin = bench_seconds();                    \
+      i = 0;                                      \
+      while (i < elements)                        \
+      {                                           \
+        neda_##_postfix##__push_back(da, (int)i); \
+        i++;                                      \
+      }                                           \
+      bench_print(#_postfix " push_back",         \
+                  elements,                       \
+                  bench_seconds() - begin);       \
+      neda_##_postfix##__free(&da);               \
+      elements <<= 2;                             \
+    }                                             \
+  }
+
+BENCH_PUSH_BACK(int_chunk)
+BENCH_PUSH_BACK(int_geometric_1_5)
+BENCH_PUSH_BACK(int_geometric_2)
+
+/* Ingesting of column with "push_back" loop and with "append_n". */
+static void bench_append(void)
+{
+  struct neda_int_geometric_2 *da;
+  int *column;
+  unsigned long i;
+  double begin;
+
+  column = (int *)malloc(sizeof(int) * BENCH_MAX_ELEMENTS);
+  i = 0;
+  while (i < BENCH_MAX_ELEMENTS)
+  {
+    column[i] = (int)i;
+    i++;
+  }
+
+  neda_int_geometric_2__init(&da);
+  neda_int_geometric_2__reserve(da, BENCH_MAX_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_MAX_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, column[i]);
+    i++;
+  }
+  bench_print("push_back loop", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__clear(da);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__append_n(da, column, BENCH_MAX_ELEMENTS);
+  bench_print("append_n", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__free(&da);
+  free(column);
+}
+
+/* "push_back" and sequential scan of 16M elements in heap and in
+ * mapped file. Mapped array grows by "mremap", so there are no
+ * reallocations.
+ */
+static void bench_mapped(void)
+{
+  struct neda_int_geometric_2 *da;
+  struct neda_int_geometric_2 mapped;
+  struct neda_mapping mapping;
+  unsigned long i;
+  long checksum = 0;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_MAX_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, (int)i);
+    i++;
+  }
+  bench_print("heap push_back", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  begin = bench_seconds();
+  checksum += neda_int_geometric_2__sum(da);
+  bench_print("heap scan", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  neda_int_geometric_2__free(&da);
+
+  remove("bench_neda_mapped.bin");
+  if (neda_int_geometric_2__init_mapped(
+          &mapped,
+          &mapping,
+          "bench_neda_mapped.bin") != NEDA_SUCCESS)
+  {
+    printf(TAB "mapped file can not be opened\n");
+    return;
+  }
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_MAX_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(&mapped, (int)i);
+    i++;
+  }
+  bench_print("mapped push_back", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  neda_mapping__advise(&mapping, POSIX_MADV_SEQUENTIAL);
+  begin = bench_seconds();
+  checksum += neda_int_geometric_2__sum(&mapped);
+  bench_print("mapped scan (sequential)", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  begin = bench_seconds();
+  neda_mapping__flush(&mapping, 1);
+  bench_print("mapped flush", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  neda_int_geometric_2__close_mapped(&mapped, &mapping);
+  remove("bench_neda_mapped.bin");
+  printf(TAB "(checksum: %ld)\n", checksum);
+}
+
+/* Snapshot of 16M elements: "save", "load" and "open_mapped" with
+ * and without checksum verification.
+ */
+static void bench_snapshot(void)
+{
+  struct neda_int_geometric_2 *da;
+  struct neda_int_geometric_2 mapped;
+  struct neda_snapshot snapshot;
+  unsigned long i;
+  long checksum = 0;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  i = 0;
+  while (i < BENCH_MAX_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, (int)i);
+    i++;
+  }
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__save(da, "bench_neda_snapshot.bin");
+  bench_print("save", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__clear(da);
+  neda_int_geometric_2__shrink_to_fit(da);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__load(da, "bench_neda_snapshot.bin");
+  bench_print("load", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  checksum += neda_int_geometric_2__at(da, BENCH_MAX_ELEMENTS - 1);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__open_mapped(
+      &mapped,
+      &snapshot,
+      "bench_neda_snapshot.bin",
+      1);
+  bench_print("open_mapped (verified)", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  checksum += neda_int_geometric_2__at(&mapped, BENCH_MAX_ELEMENTS - 1);
+  neda_int_geometric_2__close_snapshot(&mapped, &snapshot);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__open_mapped(
+      &mapped,
+      &snapshot,
+      "bench_neda_snapshot.bin",
+      0);
+  bench_print("open_mapped", BENCH_MAX_ELEMENTS, bench_seconds() - begin);
+  checksum += neda_int_geometric_2__at(&mapped, BENCH_MAX_ELEMENTS - 1);
+  neda_int_geometric_2__close_snapshot(&mapped, &snapshot);
+
+  remove("bench_neda_snapshot.bin");
+  neda_int_geometric_2__free(&da);
+  printf(TAB "(checksum: %ld)\n", checksum);
+}
+
+/* Same as default move function, but disables "memmove" fast path. */
+static void bench_move_int(int *_destination, int *_source)
+{
+  *_destination = *_source;
+}
+
+/* Shifting of 1M-element array by "push_front", "pop_front",
+ * "insert" and "erase".
+ */
+static void bench_shift(const char *_name)
+{
+  struct neda_int_geometric_2 *da;
+  unsigned long i;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  neda_int_geometric_2__fill_size(da, BENCH_SHIFT_ELEMENTS, 1);
+  neda_int_geometric_2__reserve(da, BENCH_SHIFT_ELEMENTS + 1);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SHIFT_OPERATIONS)
+  {
+    neda_int_geometric_2__push_front(da, (int)i);
+    neda_int_geometric_2__pop_front(da);
+    neda_int_geometric_2__insert(da, BENCH_SHIFT_ELEMENTS / 2, (int)i);
+    neda_int_geometric_2__erase(da, BENCH_SHIFT_ELEMENTS / 2);
+    i++;
+  }
+  bench_print(_name, BENCH_SHIFT_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__free(&da);
+}
+
+/* For "remove_if": removes odd numbers. */
+static int bench_is_odd(const int *_element, void *_context)
+{
+  NEDA_UNUSED(_context);
+  return *_element & 1;
+}
+
+/* Removal of every odd element of 64K-element array: "erase" of
+ * every element against one pass of "remove_if".
+ */
+static void bench_remove(const char *_name)
+{
+  struct neda_int_geometric_2 *da;
+  unsigned long i;
+  char name[64];
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  i = 0;
+  while (i < BENCH_REMOVE_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, (int)i);
+    i++;
+  }
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = neda_int_geometric_2__size(da);
+  while (i > 0)
+  {
+    i--;
+    if (bench_is_odd(neda_int_geometric_2__at_ptr(da, i), 0))
+    {
+      neda_int_geometric_2__erase(da, i);
+    }
+  }
+  sprintf(name, "erase loop (%s)", _name);
+  bench_print(name, BENCH_REMOVE_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__clear(da);
+  i = 0;
+  while (i < BENCH_REMOVE_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, (int)i);
+    i++;
+  }
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__remove_if(da, bench_is_odd, 0);
+  sprintf(name, "remove_if (%s)", _name);
+  bench_print(name, BENCH_REMOVE_ELEMENTS, bench_seconds() - begin);
+
+  neda_int_geometric_2__free(&da);
+}
+
+/* Work queue of 64K elements: every operation takes element from
+ * front and puts new one to back.
+ */
+static void bench_queue(void)
+{
+  struct neda_int_geometric_2 *da;
+  struct neda_deque_int *dq;
+  unsigned long i;
+  unsigned long operations;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  neda_int_geometric_2__fill_size(da, BENCH_QUEUE_ELEMENTS, 1);
+  neda_int_geometric_2__reserve(da, BENCH_QUEUE_ELEMENTS + 1);
+  /* Array queue is O(n) per operation, so it does less of them. */
+  operations = BENCH_QUEUE_OPERATIONS / 256;
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < operations)
+  {
+    neda_int_geometric_2__push_back(
+        da,
+        neda_int_geometric_2__pop_front(da) + 1);
+    i++;
+  }
+  bench_print("neda pop_front/push_back", operations, bench_seconds() - begin);
+  neda_int_geometric_2__free(&da);
+
+  neda_deque_int__init(&dq);
+  i = 0;
+  while (i < BENCH_QUEUE_ELEMENTS)
+  {
+    neda_deque_int__push_back(dq, 1);
+    i++;
+  }
+  operations = BENCH_QUEUE_OPERATIONS;
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < operations)
+  {
+    neda_deque_int__push_back(dq, neda_deque_int__pop_front(dq) + 1);
+    i++;
+  }
+  bench_print("deque pop_front/push_back", operations, bench_seconds() - begin);
+  neda_deque_int__free(&dq);
+}
+
+/* Many short-lived arrays of few elements: neda allocates header and
+ * data of each one, small array does not allocate.
+ */
+static void bench_small(void)
+{
+  struct neda_int_geometric_2 *da;
+  struct neda_int_geometric_2 in_place;
+  struct neda_small_int small;
+  unsigned long i, j;
+  long sum = 0;
+  double begin;
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SMALL_ARRAYS)
+  {
+    neda_int_geometric_2__init(&da);
+    j = 0;
+    while (j < BENCH_SMALL_ELEMENTS)
+    {
+      neda_int_geometric_2__push_back(da, (int)j);
+      j++;
+    }
+    sum += neda_int_geometric_2__at(da, i % BENCH_SMALL_ELEMENTS);
+    neda_int_geometric_2__free(&da);
+    i++;
+  }
+  bench_print("neda init/push_back/free", BENCH_SMALL_ARRAYS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SMALL_ARRAYS)
+  {
+    neda_small_int__init(&small);
+    j = 0;
+    while (j < BENCH_SMALL_ELEMENTS)
+    {
+      neda_small_int__push_back(&small, (int)j);
+      j++;
+    }
+    sum += neda_small_int__at(&small, i % BENCH_SMALL_ELEMENTS);
+    neda_small_int__destroy(&small);
+    i++;
+  }
+  bench_print("small init/push_back/destroy", BENCH_SMALL_ARRAYS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SMALL_ARRAYS)
+  {
+    neda_int_geometric_2__init_in_place(&in_place);
+    j = 0;
+    while (j < BENCH_SMALL_ELEMENTS)
+    {
+      neda_int_geometric_2__push_back(&in_place, (int)j);
+      j++;
+    }
+    sum += neda_int_geometric_2__at(&in_place, i % BENCH_SMALL_ELEMENTS);
+    neda_int_geometric_2__destroy(&in_place);
+    i++;
+  }
+  bench_print("neda init_in_place/destroy", BENCH_SMALL_ARRAYS, bench_seconds() - begin);
+  printf(TAB "(checksum: %ld)\n", sum);
+}
+
+/* Every request creates scratch arrays and drops them at the end. With
+ * arena they are dropped by one "reset".
+ */
+static void bench_request(const char *_name, struct neda_arena *_arena)
+{
+  struct neda_int_geometric_2 *arrays[BENCH_REQUEST_ARRAYS];
+  unsigned long request, array, element;
+  double begin;
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  request = 0;
+  while (request < BENCH_REQUESTS)
+  {
+    array = 0;
+    while (array < BENCH_REQUEST_ARRAYS)
+    {
+      neda_int_geometric_2__init_allocator(
+          &arrays[array],
+          _arena ? &_arena->allocator : 0);
+      element = 0;
+      while (element < BENCH_REQUEST_ELEMENTS)
+      {
+        neda_int_geometric_2__push_back(arrays[array], (int)element);
+        element++;
+      }
+      array++;
+    }
+    if (_arena)
+    {
+      neda_arena__reset(_arena);
+    }
+    else
+    {
+      array = 0;
+      while (array < BENCH_REQUEST_ARRAYS)
+      {
+        neda_int_geometric_2__free(&arrays[array]);
+        array++;
+      }
+    }
+    request++;
+  }
+  bench_print(_name, BENCH_REQUESTS, bench_seconds() - begin);
+}
+
+static int bench_compare_qsort(const void *_a, const void *_b)
+{
+  return (*(const int *)_a > *(const int *)_b) -
+         (*(const int *)_a < *(const int *)_b);
+}
+
+/* Fills array with one of patterns: random, sorted, reversed, many
+ * duplicates, sorted with 1% of random elements and 16 sorted runs.
+ */
+static void bench_fill_pattern(
+    struct neda_int_geometric_2 *_da,
+    const int _pattern,
+    const unsigned long _elements)
+{
+  unsigned long i = 0;
+  int value;
+  srand(1);
+  neda_int_geometric_2__clear(_da);
+  while (i < _elements)
+  {
+    switch (_pattern)
+    {
+    case 0:
+      value = rand();
+      break;
+    case 1:
+      value = (int)i;
+      break;
+    case 2:
+      value = (int)(_elements - i);
+      break;
+    case 3:
+      value = rand() % 16;
+      break;
+    case 4:
+      value = i % 100 ? (int)i : rand();
+      break;
+    default:
+      value = (int)(i % (_elements / 16));
+      break;
+    }
+    neda_int_geometric_2__push_back(_da, value);
+    i++;
+  }
+}
+
+static void bench_sort(void)
+{
+  const char *patterns[] = {
+      "random",
+      "sorted",
+      "reversed",
+      "duplicates",
+      "partially sorted",
+      "sorted runs"};
+  struct neda_int_geometric_2 *da;
+  struct neda_int_cmp *da_cmp;
+  char name[64];
+  int pattern = 0;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  neda_int_cmp__init(&da_cmp);
+  while (pattern < 6)
+  {
+    bench_fill_pattern(da, pattern, BENCH_SORT_ELEMENTS);
+    bench_realloc_count = 0;
+    begin = bench_seconds();
+    neda_int_geometric_2__sort(da);
+    sprintf(name, "sort %s", patterns[pattern]);
+    bench_print(name, BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+    bench_fill_pattern(da, pattern, BENCH_SORT_ELEMENTS);
+    bench_realloc_count = 0;
+    begin = bench_seconds();
+    neda_int_geometric_2__stable_sort(da);
+    sprintf(name, "stable_sort %s", patterns[pattern]);
+    bench_print(name, BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+    bench_fill_pattern(da, pattern, BENCH_SORT_ELEMENTS);
+    bench_realloc_count = 0;
+    begin = bench_seconds();
+    qsort(
+        neda_int_geometric_2__data(da),
+        neda_int_geometric_2__size(da),
+        sizeof(int),
+        bench_compare_qsort);
+    sprintf(name, "qsort %s", patterns[pattern]);
+    bench_print(name, BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+    bench_fill_pattern(da, pattern, BENCH_SORT_ELEMENTS);
+    neda_int_cmp__clear(da_cmp);
+    neda_int_cmp__append_n(
+        da_cmp,
+        neda_int_geometric_2__data(da),
+        neda_int_geometric_2__size(da));
+    bench_realloc_count = 0;
+    begin = bench_seconds();
+    neda_int_cmp__sort(da_cmp);
+    sprintf(name, "sort (CMP) %s", patterns[pattern]);
+    bench_print(name, BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+    bench_fill_pattern(da, pattern, BENCH_SORT_ELEMENTS);
+    bench_realloc_count = 0;
+    begin = bench_seconds();
+    neda_int_geometric_2__radix_sort(da);
+    sprintf(name, "radix_sort %s", patterns[pattern]);
+    bench_print(name, BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+    pattern++;
+  }
+  neda_int_cmp__free(&da_cmp);
+  neda_int_geometric_2__free(&da);
+}
+
+/* Priority queue of 1M random elements: all of them are pushed, then
+ * popped. Indexed heap also decreases key of every element once.
+ */
+#define BENCH_HEAP(_postfix)                                                          \
+  static void bench_heap_##_postfix(void)                                             \
+  {                                                                                   \
+    struct neda_##_postfix *da;                                                       \
+    struct neda_iheap_##_postfix *heap;                                               \
+    unsigned long i;                                                                  \
+    double begin;                                                                     \
+    long checksum = 0;                                                                \
+                                                                                      \
+    neda_##_postfix##__init(&da);                                                     \
+    neda_##_postfix##__reserve(da, BENCH_HEAP_ELEMENTS);                              \
+    srand(1);                                                                         \
+    bench_realloc_count = 0;                                                          \
+    begin = bench_seconds();                                                          \
+    i = 0;                                                                            \
+    while (i < BENCH_HEAP_ELEMENTS)                                                   \
+    {                                                                                 \
+      neda_##_postfix##__heap_push(da, rand());                                       \
+      i++;                                                                            \
+    }                                                                                 \
+    while (neda_##_postfix##__size(da))                                               \
+    {                                                                                 \
+      checksum += neda_##_postfix##__heap_pop(da) & 1;                                \
+    }                                                                                 \
+    bench_print(#_postfix " push/pop", BENCH_HEAP_ELEMENTS, bench_seconds() - begin); \
+                                                                                      \
+    neda_iheap_##_postfix##__init(&heap);                                             \
+    srand(1);                                                                         \
+    bench_realloc_count = 0;                                                          \
+    begin = bench_seconds();                                                          \
+    i = 0;                                                                            \
+    while (i < BENCH_HEAP_ELEMENTS)                                                   \
+    {                                                                                 \
+      neda_iheap_##_postfix##__push(heap, rand());                                    \
+      i++;                                                                            \
+    }                                                                                 \
+    i = 0;                                                                            \
+    while (i < BENCH_HEAP_ELEMENTS)                                                   \
+    {                                                                                 \
+      neda_iheap_##_postfix##__decrease_key(                                          \
+          heap,                                                                       \
+          (nedasize_t)i,                                                              \
+          neda_iheap_##_postfix##__value(heap, (nedasize_t)i) / 2);                   \
+      i++;                                                                            \
+    }                                                                                 \
+    while (neda_iheap_##_postfix##__size(heap))                                       \
+    {                                                                                 \
+      checksum += neda_iheap_##_postfix##__pop(heap) & 1;                             \
+    }                                                                                 \
+    bench_print(                                                                      \
+        #_postfix " iheap",                                                           \
+        BENCH_HEAP_ELEMENTS,                                                          \
+        bench_seconds() - begin);                                                     \
+    printf(TAB "(checksum: %ld)\n", checksum);                                        \
+                                                                                      \
+    neda_iheap_##_postfix##__free(&heap);                                             \
+    neda_##_postfix##__free(&da);                                                     \
+  }
+BENCH_HEAP(int_heap_2)
+BENCH_HEAP(int_heap_4)
+
+/* Median, p99 and top 100 of random array: full sort against
+ * selection.
+ */
+static void bench_select(void)
+{
+  struct neda_int_geometric_2 *da, *top;
+  double begin, checksum = 0.0;
+  unsigned long i;
+
+  neda_int_geometric_2__init(&da);
+  neda_int_geometric_2__init(&top);
+
+  bench_fill_pattern(da, 0, BENCH_SORT_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__sort(da);
+  checksum += neda_int_geometric_2__at(da, BENCH_SORT_ELEMENTS / 2);
+  checksum += neda_int_geometric_2__at(da, BENCH_SORT_ELEMENTS / 100 * 99);
+  bench_print("sort + median + p99", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+  bench_fill_pattern(da, 0, BENCH_SORT_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  checksum += neda_int_geometric_2__percentile(da, 50.0);
+  checksum += neda_int_geometric_2__percentile(da, 99.0);
+  bench_print("percentile median + p99", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+  bench_fill_pattern(da, 0, BENCH_SORT_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__sort(da);
+  checksum += neda_int_geometric_2__at(da, BENCH_TOP_K - 1);
+  bench_print("sort + top 100", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+  bench_fill_pattern(da, 0, BENCH_SORT_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__partial_sort(da, BENCH_TOP_K);
+  checksum += neda_int_geometric_2__at(da, BENCH_TOP_K - 1);
+  bench_print("partial_sort top 100", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+  bench_fill_pattern(da, 0, BENCH_SORT_ELEMENTS);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_int_geometric_2__top_k(da, BENCH_TOP_K, top);
+  checksum += neda_int_geometric_2__at(top, BENCH_TOP_K - 1);
+  bench_print("top_k top 100", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+
+  /* Values come one by one, array is never stored. */
+  neda_int_geometric_2__clear(top);
+  srand(1);
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SORT_ELEMENTS)
+  {
+    neda_int_geometric_2__top_k_push(top, BENCH_TOP_K, rand());
+    i++;
+  }
+  neda_int_geometric_2__sort(top);
+  checksum += neda_int_geometric_2__at(top, BENCH_TOP_K - 1);
+  bench_print("top_k_push stream top 100", BENCH_SORT_ELEMENTS, bench_seconds() - begin);
+  printf(TAB "(checksum: %.1f)\n", checksum);
+
+  neda_int_geometric_2__free(&top);
+  neda_int_geometric_2__free(&da);
+}
+
+static int bench_record_less(
+    const struct neda_soa_record *_sa,
+    const nedasize_t _a,
+    const nedasize_t _b)
+{
+  return _sa->price[_a] < _sa->price[_b];
+}
+
+/* Scan of one field: array of structs reads whole records, struct of
+ * arrays reads only column of this field.
+ */
+static void bench_soa(void)
+{
+  struct neda_record *aos;
+  struct neda_soa_record *soa;
+  struct bench_record record;
+  struct neda_soa_record__row row;
+  const double *prices;
+  unsigned long i, scan;
+  double begin, sum = 0.0;
+
+  neda_record__init(&aos);
+  neda_soa_record__init(&soa);
+  memset(&record, 0, sizeof(record));
+  srand(1);
+  i = 0;
+  while (i < BENCH_RECORDS)
+  {
+    record.price = (double)(rand() % 10000);
+    record.id = (long)i;
+    neda_record__push_back(aos, record);
+    row.price = record.price;
+    row.quantity = record.quantity;
+    row.id = record.id;
+    row.timestamp = record.timestamp;
+    neda_soa_record__push_back(soa, row);
+    i++;
+  }
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  scan = 0;
+  while (scan < BENCH_RECORD_SCANS)
+  {
+    i = 0;
+    while (i < BENCH_RECORDS)
+    {
+      sum += neda_record__at_ptr(aos, i)->price;
+      i++;
+    }
+    scan++;
+  }
+  bench_print(
+      "array of structs scan",
+      BENCH_RECORDS * BENCH_RECORD_SCANS,
+      bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  scan = 0;
+  while (scan < BENCH_RECORD_SCANS)
+  {
+    prices = neda_soa_record__price(soa);
+    i = 0;
+    while (i < BENCH_RECORDS)
+    {
+      sum += prices[i];
+      i++;
+    }
+    scan++;
+  }
+  bench_print(
+      "struct of arrays scan",
+      BENCH_RECORDS * BENCH_RECORD_SCANS,
+      bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_soa_record__sort(soa, bench_record_less);
+  bench_print("struct of arrays sort", BENCH_RECORDS, bench_seconds() - begin);
+  printf(TAB "(checksum: %.1f)\n", sum + neda_soa_record__at(soa, 0).price);
+
+  neda_soa_record__free(&soa);
+  neda_record__free(&aos);
+}
+
+/* Sparse flags (1 of 64 is set): neda of chars against bitset. Rank
+ * and select of bitset are compared with scans of chars.
+ */
+static void bench_bitset(void)
+{
+  struct neda_char *flags;
+  struct neda_bitset bits;
+  unsigned long i, value;
+  nedasize_t index, found = 0, ranked = 0;
+  double begin;
+
+  neda_char__init(&flags);
+  neda_bitset__init(&bits);
+  srand(1);
+  i = 0;
+  while (i < BENCH_BITS)
+  {
+    value = rand() % 64 == 0;
+    neda_char__push_back(flags, (char)value);
+    neda_bitset__push_back(&bits, (int)value);
+    i++;
+  }
+  printf(TAB "(memory: chars %lu KB, bitset %lu KB)\n",
+         (unsigned long)neda_char__size(flags) / 1024,
+         (unsigned long)(neda_bitset__words(BENCH_BITS) * sizeof(unsigned long) / 1024));
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  index = 0;
+  while (index < BENCH_BITS)
+  {
+    found += (nedasize_t)neda_char__at(flags, index);
+    index++;
+  }
+  bench_print("chars count", BENCH_BITS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  found -= neda_bitset__count(&bits);
+  bench_print("bitset count", BENCH_BITS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  index = 0;
+  while (index < BENCH_BITS)
+  {
+    if (neda_char__at(flags, index))
+    {
+      found++;
+    }
+    index++;
+  }
+  bench_print("chars iterate set", BENCH_BITS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  index = neda_bitset__find_next(&bits, 0);
+  while (index < BENCH_BITS)
+  {
+    found--;
+    index = neda_bitset__find_next(&bits, index + 1);
+  }
+  bench_print("bitset find_next", BENCH_BITS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  neda_bitset__build_rank(&bits);
+  bench_print("bitset build_rank", BENCH_BITS, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_BIT_QUERIES)
+  {
+    ranked += neda_bitset__rank(&bits, (nedasize_t)(((unsigned long)rand() * 4099UL) % BENCH_BITS));
+    i++;
+  }
+  bench_print("bitset rank", BENCH_BIT_QUERIES, bench_seconds() - begin);
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_BIT_QUERIES)
+  {
+    ranked += neda_bitset__select(&bits, (nedasize_t)((unsigned long)rand() % (BENCH_BITS / 64)));
+    i++;
+  }
+  bench_print("bitset select", BENCH_BIT_QUERIES, bench_seconds() - begin);
+  printf(TAB "(checksum: %lu, %lu)\n", (unsigned long)found, (unsigned long)ranked);
+
+  neda_bitset__destroy(&bits);
+  neda_char__free(&flags);
+}
+
+static void bench_print_throughput(
+    const char *_name,
+    const double _bytes,
+    const double _seconds)
+{
+  printf(
+      TAB "%-28s %8.3f GB/s;\n",
+      _name,
+      _bytes / _seconds / 1e9);
+}
+
+/* Throughput of numeric kernels over 64MB array. Value, which is
+ * searched, is not in array, so "find" reads all of it.
+ */
+#define BENCH_KERNELS(_postfix, _type)                                                  \
+  static void bench_kernels_##_postfix(void)                                            \
+  {                                                                                     \
+    struct neda_##_postfix *da;                                                         \
+    struct neda_##_postfix *da_copy;                                                    \
+    const unsigned long elements = BENCH_KERNEL_BYTES / sizeof(_type);                  \
+    const double bytes = (double)BENCH_KERNEL_BYTES * BENCH_KERNEL_REPEATS;             \
+    unsigned long i, repeat;                                                            \
+    double check = 0.0;                                                                 \
+    double begin;                                                                       \
+    neda_##_postfix##__init(&da);                                                       \
+    neda_##_postfix##__init(&da_copy);                                                  \
+    neda_##_postfix##__fill_size(da, elements, (_type)1);                               \
+    neda_##_postfix##__copy(da, da_copy);                                               \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      neda_##_postfix##__fill(da, (_type)(repeat % 8));                                 \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " fill", bytes, bench_seconds() - begin);          \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      neda_##_postfix##__copy(da, da_copy);                                             \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " copy", bytes, bench_seconds() - begin);          \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      i = 0;                                                                            \
+      while (i < elements && da->data[i] != (_type)100)                                 \
+      {                                                                                 \
+        i++;                                                                            \
+      }                                                                                 \
+      check += (double)i;                                                               \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " find (loop)", bytes, bench_seconds() - begin);   \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      check += (double)neda_##_postfix##__find(da, (_type)100);                         \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " find", bytes, bench_seconds() - begin);          \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      check += (double)neda_##_postfix##__count(da, (_type)7);                          \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " count", bytes, bench_seconds() - begin);         \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      check += (double)neda_##_postfix##__sum(da);                                      \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " sum", bytes, bench_seconds() - begin);           \
+    begin = bench_seconds();                                                            \
+    repeat = 0;                                                                         \
+    while (repeat < BENCH_KERNEL_REPEATS)                                               \
+    {                                                                                   \
+      check += (double)neda_##_postfix##__min(da);                                      \
+      check += (double)neda_##_postfix##__max(da);                                      \
+      repeat++;                                                                         \
+    }                                                                                   \
+    bench_print_throughput(#_postfix " min + max", bytes * 2, bench_seconds() - begin); \
+    printf(TAB "(checksum: %.1f)\n", check);                                            \
+    neda_##_postfix##__free(&da_copy);                                                  \
+    neda_##_postfix##__free(&da);                                                       \
+  }
+
+BENCH_KERNELS(int_geometric_2, int)
+BENCH_KERNELS(float, float)
+BENCH_KERNELS(double, double)
+
+/* Queries to sorted array of 4M even numbers. */
+static void bench_search(void)
+{
+  struct neda_int_geometric_2 *da;
+  struct neda_int_cmp *da_cmp;
+  struct neda_int_cmp *layout;
+  int *queries;
+  unsigned long i, j;
+  unsigned long found = 0;
+  double begin;
+
+  neda_int_geometric_2__init(&da);
+  neda_int_cmp__init(&da_cmp);
+  neda_int_cmp__init(&layout);
+  queries = (int *)malloc(sizeof(int) * BENCH_SEARCH_QUERIES);
+  i = 0;
+  while (i < BENCH_SEARCH_ELEMENTS)
+  {
+    neda_int_geometric_2__push_back(da, (int)(i * 2));
+    neda_int_cmp__push_back(da_cmp, (int)(i * 2));
+    i++;
+  }
+  neda_int_cmp__eytzinger_build(da_cmp, layout);
+  srand(2);
+  i = 0;
+  while (i < BENCH_SEARCH_QUERIES)
+  {
+    queries[i] = (rand() * (RAND_MAX + 1.0) + rand()) /
+                 ((RAND_MAX + 1.0) * (RAND_MAX + 1.0)) *
+                 BENCH_SEARCH_ELEMENTS * 2;
+    i++;
+  }
+
+  bench_realloc_count = 0;
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_LINEAR_QUERIES)
+  {
+    j = 0;
+    while (j < BENCH_SEARCH_ELEMENTS &&
+           neda_int_geometric_2__data(da)[j] < queries[i])
+    {
+      j++;
+    }
+    found += j;
+    i++;
+  }
+  bench_print("linear scan", BENCH_LINEAR_QUERIES, bench_seconds() - begin);
+
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SEARCH_QUERIES)
+  {
+    found += bsearch(
+                 &queries[i],
+                 neda_int_geometric_2__data(da),
+                 BENCH_SEARCH_ELEMENTS,
+                 sizeof(int),
+                 bench_compare_qsort) != 0;
+    i++;
+  }
+  bench_print("bsearch", BENCH_SEARCH_QUERIES, bench_seconds() - begin);
+
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SEARCH_QUERIES)
+  {
+    found += neda_int_geometric_2__lower_bound(da, queries[i]);
+    i++;
+  }
+  bench_print("lower_bound", BENCH_SEARCH_QUERIES, bench_seconds() - begin);
+
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SEARCH_QUERIES)
+  {
+    found += neda_int_cmp__lower_bound(da_cmp, queries[i]);
+    i++;
+  }
+  bench_print("lower_bound (CMP)", BENCH_SEARCH_QUERIES, bench_seconds() - begin);
+
+  begin = bench_seconds();
+  i = 0;
+  while (i < BENCH_SEARCH_QUERIES)
+  {
+    found += neda_int_cmp__eytzinger_lower_bound(layout, queries[i]);
+    i++;
+  }
+  bench_print("eytzinger_lower_bound (CMP)", BENCH_SEARCH_QUERIES, bench_seconds() - begin);
+  printf(TAB "(checksum: %lu)\n", found);
+
+  free(queries);
+  neda_int_cmp__free(&layout);
+  neda_int_cmp__free(&da_cmp);
+  neda_int_geometric_2__free(&da);
+}
+
+int main(void)
+{
+  printf("neda library benchmark:\n");
+
+  printf("\nGrowth policies:\n");
+  bench_push_back_int_chunk();
+  bench_push_back_int_geometric_1_5();
+  bench_push_back_int_geometric_2();
+
+  printf("\nBulk append:\n");
+  bench_append();
+
+  printf("\nFile-backed array:\n");
+  bench_mapped();
+
+  printf("\nSnapshots:\n");
+  bench_snapshot();
+
+  printf("\nShifts (%d x push_front/pop_front/insert/erase):\n",
+         BENCH_SHIFT_OPERATIONS);
+  neda_int_geometric_2__set_move_function(bench_move_int);
+  bench_shift("move callback");
+  neda_int_geometric_2__set_default_move_function();
+  bench_shift("memmove");
+
+  printf("\nBulk removal (every second element):\n");
+  neda_int_geometric_2__set_move_function(bench_move_int);
+  bench_remove("move callback");
+  neda_int_geometric_2__set_default_move_function();
+  bench_remove("memmove");
+
+  printf("\nWork queue (%d elements, ns per operation):\n",
+         BENCH_QUEUE_ELEMENTS);
+  bench_queue();
+
+  printf("\nSmall arrays (%d elements, ns per array):\n",
+         BENCH_SMALL_ELEMENTS);
+  bench_small();
+
+  printf("\nRequests (%d arrays of %d elements, ns per request):\n",
+         BENCH_REQUEST_ARRAYS,
+         BENCH_REQUEST_ELEMENTS);
+  bench_request("malloc", 0);
+  {
+    struct neda_arena arena;
+    neda_arena__init(&arena, 0);
+    bench_request("arena", &arena);
+    neda_arena__destroy(&arena);
+  }
+
+  printf("\nSorting:\n");
+  neda_int_geometric_2__set_default_compare_function();
+  bench_sort();
+
+  printf("\nSelection:\n");
+  bench_select();
+
+  printf("\nPriority queue (ns per element):\n");
+  bench_heap_int_heap_2();
+  bench_heap_int_heap_4();
+
+  printf("\nBitset (%d flags, ns per flag or query):\n", BENCH_BITS);
+  bench_bitset();
+
+  printf("\nField scan (%d records of %d bytes, ns per record):\n",
+         BENCH_RECORDS,
+         (int)sizeof(struct bench_record));
+  bench_soa();
+
+  printf("\nSearch (%d sorted elements, ns per query):\n",
+         BENCH_SEARCH_ELEMENTS);
+  bench_search();
+
+  printf("\nNumeric kernels (%d MB array):\n", BENCH_KERNEL_BYTES >> 20);
+  bench_kernels_int_geometric_2();
+  bench_kernels_float();
+  bench_kernels_double();
+
+  return 0;
+}
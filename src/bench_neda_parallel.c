@@ -0,0 +1,91 @@
+#define _POSIX_C_SOURCE 199309L
+#define NDEBUG
+#define NEDA_PTHREAD
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../include/neda.h"
+
+#define TAB "  " /* two spaces */
+#define BENCH_ELEMENTS (1 << 24)
+#define BENCH_MAX_THREADS 64U
+
+NEDA_HEADER(int)
+NEDA_BODY_IMPLEMENTATION_GROWTH(int, 128, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_PARALLEL_HEADER(int)
+NEDA_PARALLEL_BODY_IMPLEMENTATION(int)
+
+static double bench_seconds(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+  struct neda_int *da;
+  unsigned int threads_count = 1;
+  unsigned int max_threads;
+  unsigned long i;
+  double begin, seconds, first_seconds = 0.0;
+  int sorted;
+  long processors;
+
+  processors = sysconf(_SC_NPROCESSORS_ONLN);
+  max_threads = processors > 4 ? (unsigned int)processors : 4U;
+  if (max_threads > BENCH_MAX_THREADS)
+  {
+    max_threads = BENCH_MAX_THREADS;
+  }
+
+  neda_int__init(&da);
+  neda_int__set_default_functions();
+
+  printf("neda parallel_sort benchmark (%d elements, %ld processors):\n",
+         BENCH_ELEMENTS,
+         processors);
+
+  while (threads_count <= max_threads)
+  {
+    srand(1);
+    neda_int__clear(da);
+    i = 0;
+    while (i < BENCH_ELEMENTS)
+    {
+      neda_int__push_back(da, rand());
+      i++;
+    }
+
+    begin = bench_seconds();
+    neda_int__parallel_sort(da, threads_count);
+    seconds = bench_seconds() - begin;
+    if (threads_count == 1)
+    {
+      first_seconds = seconds;
+    }
+
+    sorted = 1;
+    i = 1;
+    while (i < BENCH_ELEMENTS)
+    {
+      sorted &= neda_int__at(da, i - 1) <= neda_int__at(da, i);
+      i++;
+    }
+
+    printf(
+        TAB "threads: %2u; %9.3f ms; speedup: %5.2fx; sorted: %s;\n",
+        threads_count,
+        seconds * 1e3,
+        first_seconds / seconds,
+        sorted ? "yes" : "NO");
+
+    threads_count *= 2;
+  }
+
+  neda_int__free(&da);
+  return 0;
+}
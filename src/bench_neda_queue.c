@@ -0,0 +1,415 @@
+#define _POSIX_C_SOURCE 199309L
+#define NDEBUG
+#define NEDA_ATOMIC
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "../include/neda.h"
+
+#define TAB "  " /* two spaces */
+#define BENCH_MESSAGES (1 << 22)
+#define BENCH_ROUND_TRIPS (1 << 16)
+#define BENCH_CAPACITY 1024
+#define BENCH_MAX_THREADS 4
+
+NEDA_HEADER(long)
+NEDA_BODY_IMPLEMENTATION_GROWTH(long, 128, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_DEQUE_HEADER(long)
+NEDA_DEQUE_BODY_IMPLEMENTATION(long)
+NEDA_SPSC_HEADER(long)
+NEDA_SPSC_BODY_IMPLEMENTATION(long)
+NEDA_MPMC_HEADER(long)
+NEDA_MPMC_BODY_IMPLEMENTATION(long)
+NEDA_SEGMENTED_HEADER(long)
+NEDA_SEGMENTED_BODY_IMPLEMENTATION(long)
+
+/* Baseline: neda deque under mutex, bounded like lock-free queues. */
+struct bench_locked
+{
+  pthread_mutex_t mutex;
+  struct neda_deque_long *deque;
+};
+
+static int bench_locked__try_push(struct bench_locked *_queue, const long _value)
+{
+  int pushed = 0;
+  pthread_mutex_lock(&_queue->mutex);
+  if (neda_deque_long__size(_queue->deque) < BENCH_CAPACITY)
+  {
+    neda_deque_long__push_back(_queue->deque, _value);
+    pushed = 1;
+  }
+  pthread_mutex_unlock(&_queue->mutex);
+  return pushed;
+}
+
+static int bench_locked__try_pop(struct bench_locked *_queue, long *_value)
+{
+  int popped = 0;
+  pthread_mutex_lock(&_queue->mutex);
+  if (neda_deque_long__size(_queue->deque))
+  {
+    *_value = neda_deque_long__pop_front(_queue->deque);
+    popped = 1;
+  }
+  pthread_mutex_unlock(&_queue->mutex);
+  return popped;
+}
+
+/* Every queue kind is used through the same two functions. */
+struct bench_queue
+{
+  int (*try_push)(void *_queue, const long _value);
+  int (*try_pop)(void *_queue, long *_value);
+  void *queue;
+};
+
+static int bench_locked_push(void *_queue, const long _value)
+{
+  return bench_locked__try_push((struct bench_locked *)_queue, _value);
+}
+static int bench_locked_pop(void *_queue, long *_value)
+{
+  return bench_locked__try_pop((struct bench_locked *)_queue, _value);
+}
+static int bench_spsc_push(void *_queue, const long _value)
+{
+  return neda_spsc_long__try_push((struct neda_spsc_long *)_queue, _value);
+}
+static int bench_spsc_pop(void *_queue, long *_value)
+{
+  return neda_spsc_long__try_pop((struct neda_spsc_long *)_queue, _value);
+}
+static int bench_mpmc_push(void *_queue, const long _value)
+{
+  return neda_mpmc_long__try_push((struct neda_mpmc_long *)_queue, _value);
+}
+static int bench_mpmc_pop(void *_queue, long *_value)
+{
+  return neda_mpmc_long__try_pop((struct neda_mpmc_long *)_queue, _value);
+}
+
+/* Job of one producer or consumer thread. */
+struct bench_job
+{
+  struct bench_queue *queue;
+  long count;
+  long sum;
+};
+
+static void *bench_producer(void *_job)
+{
+  struct bench_job *job = (struct bench_job *)_job;
+  long i = 1;
+  while (i <= job->count)
+  {
+    /* Thread yields instead of spinning, so benchmark works even on
+       one processor. */
+    while (!job->queue->try_push(job->queue->queue, i))
+    {
+      sched_yield();
+    }
+    i++;
+  }
+  return 0;
+}
+
+static void *bench_consumer(void *_job)
+{
+  struct bench_job *job = (struct bench_job *)_job;
+  long i = 0, value;
+  job->sum = 0;
+  while (i < job->count)
+  {
+    while (!job->queue->try_pop(job->queue->queue, &value))
+    {
+      sched_yield();
+    }
+    job->sum += value;
+    i++;
+  }
+  return 0;
+}
+
+static double bench_seconds(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+/* Runs "_threads" producers and "_threads" consumers, every producer
+ * pushes "BENCH_MESSAGES / _threads" values. */
+static void bench_throughput(
+    const char *_name,
+    struct bench_queue *_queue,
+    const int _threads)
+{
+  pthread_t producers[BENCH_MAX_THREADS], consumers[BENCH_MAX_THREADS];
+  struct bench_job producer_jobs[BENCH_MAX_THREADS];
+  struct bench_job consumer_jobs[BENCH_MAX_THREADS];
+  const long count = BENCH_MESSAGES / _threads;
+  long sum = 0, expected;
+  double begin, seconds;
+  int i = 0;
+
+  begin = bench_seconds();
+  while (i < _threads)
+  {
+    producer_jobs[i].queue = _queue;
+    producer_jobs[i].count = count;
+    consumer_jobs[i].queue = _queue;
+    consumer_jobs[i].count = count;
+    pthread_create(&consumers[i], 0, bench_consumer, &consumer_jobs[i]);
+    pthread_create(&producers[i], 0, bench_producer, &producer_jobs[i]);
+    i++;
+  }
+  i = 0;
+  while (i < _threads)
+  {
+    pthread_join(producers[i], 0);
+    pthread_join(consumers[i], 0);
+    sum += consumer_jobs[i].sum;
+    i++;
+  }
+  seconds = bench_seconds() - begin;
+  expected = (long)_threads * (count * (count + 1) / 2);
+
+  printf(
+      TAB "%-22s %dP/%dC: %9.3f ms; %7.2f Mmsg/s; checksum: %s;\n",
+      _name,
+      _threads,
+      _threads,
+      seconds * 1e3,
+      (double)count * _threads / seconds / 1e6,
+      sum == expected ? "ok" : "WRONG");
+}
+
+/* Echo thread of latency benchmark: returns every message back. */
+struct bench_echo
+{
+  struct bench_queue *request, *response;
+};
+
+static void *bench_echo_thread(void *_echo)
+{
+  struct bench_echo *echo = (struct bench_echo *)_echo;
+  long i = 0, value;
+  while (i < BENCH_ROUND_TRIPS)
+  {
+    while (!echo->request->try_pop(echo->request->queue, &value))
+    {
+      sched_yield();
+    }
+    while (!echo->response->try_push(echo->response->queue, value))
+    {
+      sched_yield();
+    }
+    i++;
+  }
+  return 0;
+}
+
+static void bench_latency(
+    const char *_name,
+    struct bench_queue *_request,
+    struct bench_queue *_response)
+{
+  struct bench_echo echo;
+  pthread_t thread;
+  long i = 0, value;
+  double begin, seconds;
+
+  echo.request = _request;
+  echo.response = _response;
+  pthread_create(&thread, 0, bench_echo_thread, &echo);
+  begin = bench_seconds();
+  while (i < BENCH_ROUND_TRIPS)
+  {
+    while (!_request->try_push(_request->queue, i))
+    {
+      sched_yield();
+    }
+    while (!_response->try_pop(_response->queue, &value))
+    {
+      sched_yield();
+    }
+    i++;
+  }
+  seconds = bench_seconds() - begin;
+  pthread_join(thread, 0);
+
+  printf(
+      TAB "%-22s round trip: %9.3f us;\n",
+      _name,
+      seconds * 1e6 / BENCH_ROUND_TRIPS);
+}
+
+/* Job of appending thread: to neda under mutex or to segmented array. */
+struct bench_append
+{
+  pthread_mutex_t *mutex;
+  struct neda_long *da;
+  struct neda_segmented_long *sa;
+  long count;
+};
+
+static void *bench_append_locked(void *_job)
+{
+  struct bench_append *job = (struct bench_append *)_job;
+  long i = 1;
+  while (i <= job->count)
+  {
+    pthread_mutex_lock(job->mutex);
+    neda_long__push_back(job->da, i);
+    pthread_mutex_unlock(job->mutex);
+    i++;
+  }
+  return 0;
+}
+
+static void *bench_append_segmented(void *_job)
+{
+  struct bench_append *job = (struct bench_append *)_job;
+  long i = 1;
+  while (i <= job->count)
+  {
+    neda_segmented_long__push_back(job->sa, i);
+    i++;
+  }
+  return 0;
+}
+
+/* "_threads" threads append BENCH_MESSAGES values together. For
+ * segmented array time includes "flatten" into regular neda. */
+static void bench_append(const int _threads, const int _segmented)
+{
+  pthread_t threads[BENCH_MAX_THREADS];
+  struct bench_append jobs[BENCH_MAX_THREADS];
+  pthread_mutex_t mutex;
+  struct neda_long *da;
+  struct neda_segmented_long *sa;
+  const long count = BENCH_MESSAGES / _threads;
+  long sum = 0, expected;
+  double begin, seconds;
+  nedasize_t j = 0;
+  int i = 0;
+
+  pthread_mutex_init(&mutex, 0);
+  neda_long__init(&da);
+  neda_segmented_long__init(&sa);
+  begin = bench_seconds();
+  while (i < _threads)
+  {
+    jobs[i].mutex = &mutex;
+    jobs[i].da = da;
+    jobs[i].sa = sa;
+    jobs[i].count = count;
+    pthread_create(
+        &threads[i],
+        0,
+        _segmented ? bench_append_segmented : bench_append_locked,
+        &jobs[i]);
+    i++;
+  }
+  i = 0;
+  while (i < _threads)
+  {
+    pthread_join(threads[i], 0);
+    i++;
+  }
+  if (_segmented)
+  {
+    neda_segmented_long__flatten(sa, da);
+  }
+  seconds = bench_seconds() - begin;
+  while (j < neda_long__size(da))
+  {
+    sum += neda_long__at(da, j);
+    j++;
+  }
+  expected = (long)_threads * (count * (count + 1) / 2);
+
+  printf(
+      TAB "%-22s %d threads: %9.3f ms; %7.2f Mpush/s; checksum: %s;\n",
+      _segmented ? "neda_segmented" : "neda with mutex",
+      _threads,
+      seconds * 1e3,
+      (double)count * _threads / seconds / 1e6,
+      sum == expected ? "ok" : "WRONG");
+
+  neda_segmented_long__free(&sa);
+  neda_long__free(&da);
+  pthread_mutex_destroy(&mutex);
+}
+
+int main(void)
+{
+  struct bench_locked locked[2];
+  struct neda_spsc_long *spsc[2];
+  struct neda_mpmc_long *mpmc[2];
+  struct bench_queue locked_queues[2], spsc_queues[2], mpmc_queues[2];
+  int i = 0, threads;
+
+  while (i < 2)
+  {
+    pthread_mutex_init(&locked[i].mutex, 0);
+    neda_deque_long__init(&locked[i].deque);
+    neda_spsc_long__init(&spsc[i], BENCH_CAPACITY);
+    neda_mpmc_long__init(&mpmc[i], BENCH_CAPACITY);
+    locked_queues[i].try_push = bench_locked_push;
+    locked_queues[i].try_pop = bench_locked_pop;
+    locked_queues[i].queue = &locked[i];
+    spsc_queues[i].try_push = bench_spsc_push;
+    spsc_queues[i].try_pop = bench_spsc_pop;
+    spsc_queues[i].queue = spsc[i];
+    mpmc_queues[i].try_push = bench_mpmc_push;
+    mpmc_queues[i].try_pop = bench_mpmc_pop;
+    mpmc_queues[i].queue = mpmc[i];
+    i++;
+  }
+
+  printf("neda queue benchmark (%d messages, capacity %d):\n",
+         BENCH_MESSAGES,
+         BENCH_CAPACITY);
+  printf("\nThroughput:\n");
+  bench_throughput("deque with mutex", &locked_queues[0], 1);
+  bench_throughput("neda_spsc", &spsc_queues[0], 1);
+  bench_throughput("neda_mpmc", &mpmc_queues[0], 1);
+  threads = 2;
+  while (threads <= BENCH_MAX_THREADS)
+  {
+    bench_throughput("deque with mutex", &locked_queues[0], threads);
+    bench_throughput("neda_mpmc", &mpmc_queues[0], threads);
+    threads *= 2;
+  }
+
+  printf("\nLatency (%d round trips):\n", BENCH_ROUND_TRIPS);
+  bench_latency("deque with mutex", &locked_queues[0], &locked_queues[1]);
+  bench_latency("neda_spsc", &spsc_queues[0], &spsc_queues[1]);
+  bench_latency("neda_mpmc", &mpmc_queues[0], &mpmc_queues[1]);
+
+  printf("\nConcurrent append:\n");
+  threads = 1;
+  while (threads <= BENCH_MAX_THREADS)
+  {
+    bench_append(threads, 0);
+    bench_append(threads, 1);
+    threads *= 2;
+  }
+
+  i = 0;
+  while (i < 2)
+  {
+    pthread_mutex_destroy(&locked[i].mutex);
+    neda_deque_long__free(&locked[i].deque);
+    neda_spsc_long__free(&spsc[i]);
+    neda_mpmc_long__free(&mpmc[i]);
+    i++;
+  }
+  return 0;
+}
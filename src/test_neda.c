@@ -1,10 +1,13 @@
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 
 #include <stdio.h>
 #include <time.h>
 #include <assert.h>
 
 #define NEDA_STATIC
+#define NEDA_MMAP
+#define NEDA_ATOMIC
+#define NEDA_PTHREAD
 #define NDEBUG
 
 #define PRINT_TESTS 1
@@ -12,11 +15,86 @@
 #define ASSERT_FAILS 0
 
 #define DEFAULT_CHUNK 128U
+#define BIG_ARRAY_SIZE 100000U
 #define TAB "  " /* two spaces */
 
 #include "../include/neda.h"
 NEDA_HEADER(float)
 NEDA_BODY_IMPLEMENTATION(float, DEFAULT_CHUNK)
+NEDA_PARALLEL_HEADER(float)
+NEDA_PARALLEL_BODY_IMPLEMENTATION(float)
+NEDA_RADIX_HEADER(float)
+NEDA_RADIX_BODY_IMPLEMENTATION(float, NEDA_RADIX_FLOAT)
+NEDA_RADIX_KEY_HEADER(float, integer_part)
+NEDA_RADIX_KEY_BODY_IMPLEMENTATION(float, integer_part, int, NEDA_RADIX_SIGNED, (int)*_element)
+NEDA_DEQUE_HEADER(float)
+NEDA_DEQUE_BODY_IMPLEMENTATION(float)
+NEDA_SMALL_HEADER(float, 8)
+NEDA_SMALL_BODY_IMPLEMENTATION(float)
+NEDA_NUMERIC_HEADER(float, double)
+NEDA_NUMERIC_BODY_IMPLEMENTATION(float, double)
+NEDA_SNAPSHOT_HEADER(float)
+NEDA_SNAPSHOT_BODY_IMPLEMENTATION(float)
+NEDA_MAPPED_HEADER(float)
+NEDA_MAPPED_BODY_IMPLEMENTATION(float)
+NEDA_SPSC_HEADER(float)
+NEDA_SPSC_BODY_IMPLEMENTATION(float)
+NEDA_MPMC_HEADER(float)
+NEDA_MPMC_BODY_IMPLEMENTATION(float)
+NEDA_SEGMENTED_HEADER(float)
+NEDA_SEGMENTED_BODY_IMPLEMENTATION(float)
+NEDA_HEAP_HEADER(float)
+NEDA_HEAP_BODY_IMPLEMENTATION_ARITY(float, 4)
+#define POINT_FIELDS(_field, _argument) \
+  _field(_argument, float, x)           \
+  _field(_argument, unsigned int, id)
+NEDA_SOA_HEADER(point, POINT_FIELDS)
+NEDA_SOA_BODY_IMPLEMENTATION(point, POINT_FIELDS)
+
+/* Arrays for growth policies and comparator testing. Only few of their functions are
+ * used, so unused ones should not fail the build. */
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+NEDA_HEADER_POSTFIX(float_1_5, float)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(float_1_5, float, 4U, NEDA_GROWTH_GEOMETRIC_1_5)
+NEDA_HEADER_POSTFIX(float_2, float)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(float_2, float, 4U, NEDA_GROWTH_GEOMETRIC_2)
+NEDA_HEADER_POSTFIX(float_grow, float)
+NEDA_BODY_IMPLEMENTATION_GROWTH_POSTFIX(float_grow, float, 4U, NEDA_GROWTH_CALLBACK)
+/* Array with comparison built into sort functions: descending order. */
+NEDA_HEADER_POSTFIX(float_desc, float)
+NEDA_BODY_IMPLEMENTATION_CMP_POSTFIX(float_desc, float, DEFAULT_CHUNK, *_a > *_b)
+NEDA_HEAP_HEADER_POSTFIX(float_desc, float)
+NEDA_HEAP_BODY_IMPLEMENTATION_POSTFIX(float_desc, float)
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/* For growth policies testing: pushes "GROWTH_PUSHES" values into
+ * array and writes every new capacity into "_capacities". */
+#define GROWTH_PUSHES 300U
+#define GROWTH_CAPACITIES(_postfix, _capacities, _count)            \
+  {                                                                 \
+    struct neda_##_postfix *growth_da;                              \
+    unsigned int growth_index = 0;                                  \
+    _count = 0;                                                     \
+    neda_##_postfix##__init(&growth_da);                            \
+    while (growth_index < GROWTH_PUSHES)                            \
+    {                                                               \
+      neda_##_postfix##__push_back(growth_da, (float)growth_index); \
+      if (!_count ||                                                \
+          _capacities[_count - 1] !=                                \
+              neda_##_postfix##__capacity(growth_da))               \
+      {                                                             \
+        _capacities[_count++] =                                     \
+            neda_##_postfix##__capacity(growth_da);                 \
+      }                                                             \
+      growth_index++;                                               \
+    }                                                               \
+    neda_##_postfix##__free(&growth_da);                            \
+  }
 
 /* For "basic_sort" testing. */
 int compare_revers(const float *_a, const float *_b)
@@ -24,6 +102,63 @@ int compare_revers(const float *_a, const float *_b)
   return *_b - *_a;
 }
 
+/* For "set_functions" testing: "sort" places "_a" first, if it is
+ * greater. */
+int compare_greater(const float *_a, const float *_b)
+{
+  return *_a > *_b;
+}
+
+/* For "stable_sort" testing: only integer parts are compared, so
+ * fractional parts show original order of equal elements. */
+int compare_integer_part(const float *_a, const float *_b)
+{
+  return (int)*_a < (int)*_b;
+}
+
+/* For "set_swap_function" and "set_move_function" testing: sorting
+ * should use them, if they are not default. */
+unsigned int swap_calls = 0;
+unsigned int move_calls = 0;
+
+void swap_counted(float *_a, float *_b)
+{
+  const float temp = *_a;
+  *_a = *_b;
+  *_b = temp;
+  swap_calls++;
+}
+
+void move_counted(float *_destination, float *_source)
+{
+  *_destination = *_source;
+  move_calls++;
+}
+
+/* For "set_growth_function" testing: capacity grows by 10 elements. */
+unsigned int growth_calls = 0;
+
+nedasize_t grow_by_ten(const nedasize_t _capacity, const nedasize_t _size)
+{
+  growth_calls++;
+  return _capacity + 10U > _size ? _capacity + 10U : _size;
+}
+
+/* For "remove_if" testing: "_context" points to the limit. */
+int is_greater(const float *_element, void *_context)
+{
+  return *_element > *(const float *)_context;
+}
+
+/* For "neda_soa_point__sort" testing: rows are ordered by "x". */
+int point_x_less(
+    const struct neda_soa_point *_sa,
+    const nedasize_t _a,
+    const nedasize_t _b)
+{
+  return _sa->x[_a] < _sa->x[_b];
+}
+
 int main(void)
 {
   /* "register" keyword speeds-up testing a little, suddenly. */
@@ -51,9 +186,8 @@ int main(void)
   clock_gettime(CLOCK_MONOTONIC, &tests_begin_time);
 #endif
 
-  (void)neda_float__set_move_function;
-  (void)neda_float__set_swap_function;
   (void)neda_float__memset;
+  (void)neda_float__set_growth_function;
 
   /* neda_float__reserve() test: */
   {
@@ -97,6 +231,103 @@ int main(void)
 
     tests_passed_temp &= temp_int == DEFAULT_CHUNK * 2;
 
+    /* Reserve math should be exact above 2^24 (float precision). */
+    temp_int = NEDA_CHUNK_RESERVE(DEFAULT_CHUNK, 16777217U);
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Reserve math (above 2^24):          %.3u; "
+            "Expected: %.3u;\n",
+        temp_int,
+        16777344U);
+#endif
+
+    tests_passed_temp &= temp_int == 16777344U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* NEDA_GROWTH_CHUNK,
+   * NEDA_GROWTH_GEOMETRIC_1_5,
+   * NEDA_GROWTH_GEOMETRIC_2,
+   * NEDA_GROWTH_CALLBACK test:
+   */
+  {
+    static const unsigned int expected_chunk[] = {128U, 256U, 384U};
+    static const unsigned int expected_1_5[] = {
+        4U, 8U, 12U, 18U, 27U, 40U, 60U, 90U, 135U, 202U, 303U};
+    static const unsigned int expected_2[] = {
+        4U, 8U, 16U, 32U, 64U, 128U, 256U, 512U};
+    unsigned int capacities[GROWTH_PUSHES];
+    unsigned int count;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nNEDA_GROWTH_CHUNK,\n"
+           "NEDA_GROWTH_GEOMETRIC_1_5,\n"
+           "NEDA_GROWTH_GEOMETRIC_2,\n"
+           "NEDA_GROWTH_CALLBACK test:\n");
+#endif
+
+    GROWTH_CAPACITIES(float, capacities, count);
+    temp_int = count == sizeof(expected_chunk) / sizeof(expected_chunk[0]) &&
+               !memcmp(capacities, expected_chunk, sizeof(expected_chunk));
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Chunk capacities (128, 256, 384):       %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    GROWTH_CAPACITIES(float_1_5, capacities, count);
+    temp_int = count == sizeof(expected_1_5) / sizeof(expected_1_5[0]) &&
+               !memcmp(capacities, expected_1_5, sizeof(expected_1_5));
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Geometric 1.5 capacities (4, 8, 12...): %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    GROWTH_CAPACITIES(float_2, capacities, count);
+    temp_int = count == sizeof(expected_2) / sizeof(expected_2[0]) &&
+               !memcmp(capacities, expected_2, sizeof(expected_2));
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Geometric 2 capacities (4, 8, 16...):   %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Without growth function callback policy falls back to chunk. */
+    GROWTH_CAPACITIES(float_grow, capacities, count);
+    temp_int = count == GROWTH_PUSHES / 4U &&
+               capacities[0] == 4U &&
+               capacities[count - 1] == GROWTH_PUSHES;
+    neda_float_grow__set_growth_function(grow_by_ten);
+    GROWTH_CAPACITIES(float_grow, capacities, count);
+    temp_int &= growth_calls == count &&
+                count == GROWTH_PUSHES / 10U &&
+                capacities[0] == 10U &&
+                capacities[count - 1] == GROWTH_PUSHES;
+    neda_float_grow__set_growth_function(0);
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Callback capacities (10, 20, 30...):    %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
     if (tests_passed_temp)
     {
       tests_passed++;
@@ -606,6 +837,124 @@ int main(void)
 #endif
   }
 
+  /* neda_float__append_n(),
+   * neda_float__insert_range(),
+   * neda_float__erase_range() test:
+   */
+  {
+    const float values[] = {1.1f, 2.2f, 3.3f, 4.4f, 5.5f};
+    const float inserted[] = {7.7f, 8.8f};
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__append_n(),\n"
+           "neda_float__insert_range(),\n"
+           "neda_float__erase_range() test:\n");
+#endif
+
+    neda_float__append_n(da, values, 5);
+    temp_int = neda_float__size(da);
+#if PRINT_TESTS != 0
+    printf(TAB "(5 values appended to array)\n");
+    printf(TAB "Array size:                    %.3u; "
+               "Expected: %.3u;\n",
+           temp_int,
+           5U);
+#endif
+    tests_passed_temp &= temp_int == 5U;
+
+    neda_float__insert_range(da, 1, inserted, 2);
+#if PRINT_TESTS != 0
+    printf(TAB "(insert 7.7 and 8.8 before 2.2 (index 1))\n");
+#endif
+    temp_int = neda_float__size(da);
+    index = 0;
+    while (index < temp_int)
+    {
+      temp_float = neda_float__at(da, index);
+      (void)(temp_float);
+#if PRINT_TESTS != 0
+      printf(
+          TAB TAB "Index: %u; Value: %.1f\n",
+          index,
+          temp_float);
+#endif
+      index++;
+    }
+    tests_passed_temp &= temp_int == 7U &&
+                         neda_float__at(da, 0) == 1.1f &&
+                         neda_float__at(da, 1) == 7.7f &&
+                         neda_float__at(da, 2) == 8.8f &&
+                         neda_float__at(da, 3) == 2.2f &&
+                         neda_float__at(da, 6) == 5.5f;
+
+    neda_float__erase_range(da, 0, 3);
+#if PRINT_TESTS != 0
+    printf(TAB "(erase first 3 values)\n");
+#endif
+    temp_int = neda_float__size(da);
+    index = 0;
+    while (index < temp_int)
+    {
+      temp_float = neda_float__at(da, index);
+      (void)(temp_float);
+#if PRINT_TESTS != 0
+      printf(
+          TAB TAB "Index: %u; Value: %.1f\n",
+          index,
+          temp_float);
+#endif
+      index++;
+    }
+    tests_passed_temp &= temp_int == 4U &&
+                         neda_float__at(da, 0) == 2.2f &&
+                         neda_float__at(da, 3) == 5.5f;
+
+    /* Values can be taken from the same array, even if it is
+     * reallocated. */
+    neda_float__init(&da_copy);
+    index = 0;
+    while (index < DEFAULT_CHUNK)
+    {
+      neda_float__push_back(da_copy, (float)index);
+      index++;
+    }
+    neda_float__append_n(da_copy, neda_float__data(da_copy), DEFAULT_CHUNK);
+    neda_float__insert_range(da_copy, 10U, neda_float__data(da_copy) + 5, 10U);
+    temp_int = neda_float__size(da_copy) == DEFAULT_CHUNK * 2U + 10U;
+    index = 0;
+    while (index < DEFAULT_CHUNK * 2U + 10U)
+    {
+      temp_float = index < 10U    ? (float)index
+                   : index < 20U  ? (float)(index - 5U)
+                   : index < DEFAULT_CHUNK + 10U
+                       ? (float)(index - 10U)
+                       : (float)(index - DEFAULT_CHUNK - 10U);
+      temp_int &= neda_float__at(da_copy, index) == temp_float;
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(TAB "(append and insert values of array itself)\n");
+    printf(TAB "Values are copied:             %.3u; "
+               "Expected: %.3u;\n",
+           temp_int,
+           1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+    neda_float__free(&da_copy);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
   /*
    * neda_float__sort()
    * neda_float__quick_sort() test:
@@ -701,6 +1050,1839 @@ int main(void)
 #endif
   }
 
+  /* neda_float__set_swap_function(),
+   * neda_float__set_move_function() test:
+   */
+  {
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__set_swap_function(),\n"
+           "neda_float__set_move_function() test:\n");
+#endif
+
+    neda_float__set_default_compare_function();
+    neda_float__set_swap_function(swap_counted);
+    neda_float__set_move_function(move_counted);
+    index = 0;
+    while (index < 200U)
+    {
+      neda_float__push_back(da, (float)((index * 37U) % 200U));
+      index++;
+    }
+    neda_float__sort(da);
+    temp_int = 1;
+    index = 1;
+    while (index < 200U)
+    {
+      temp_int &= neda_float__at(da, index - 1) < neda_float__at(da, index);
+      index++;
+    }
+    temp_int &= swap_calls > 0U && move_calls > 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "sort used callbacks and sorted:       %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    swap_calls = 0;
+    move_calls = 0;
+    neda_float__quick_sort(da);
+    neda_float__nth_element(da, 100U);
+    temp_int = neda_float__at(da, 100U) == 100.0f &&
+               swap_calls > 0U && move_calls > 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "nth_element used callbacks:           %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_float__set_default_swap_function();
+    neda_float__set_default_move_function();
+    swap_calls = 0;
+    move_calls = 0;
+    neda_float__sort(da);
+    temp_int = swap_calls == 0U && move_calls == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Default functions are not called:     %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__sort() test on big arrays: */
+  {
+    const char *patterns[] = {"random", "sorted", "reversed", "duplicates"};
+    register unsigned int pattern = 0;
+    register unsigned int random = 12345U;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__sort() test on big arrays:\n");
+#endif
+
+    while (pattern < 4)
+    {
+      neda_float__clear(da);
+      index = 0;
+      while (index < BIG_ARRAY_SIZE)
+      {
+        random = random * 1103515245U + 12345U;
+        switch (pattern)
+        {
+        case 0:
+          temp_float = (float)(random >> 8);
+          break;
+        case 1:
+          temp_float = (float)index;
+          break;
+        case 2:
+          temp_float = (float)(BIG_ARRAY_SIZE - index);
+          break;
+        default:
+          temp_float = (float)((random >> 8) % 16U);
+          break;
+        }
+        neda_float__push_back(da, temp_float);
+        index++;
+      }
+
+      neda_float__sort(da);
+
+      temp_int = 1;
+      index = 1;
+      while (index < BIG_ARRAY_SIZE)
+      {
+        temp_int &= !(neda_float__at(da, index) < neda_float__at(da, index - 1));
+        index++;
+      }
+#if PRINT_TESTS != 0
+      printf(
+          TAB "%-10s (%u values) sorted: %u; Expected: %u;\n",
+          patterns[pattern],
+          BIG_ARRAY_SIZE,
+          temp_int,
+          1U);
+#endif
+      (void)(patterns);
+      tests_passed_temp &= temp_int == 1U;
+      pattern++;
+    }
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__parallel_sort() test: */
+  {
+    static const unsigned int threads[] = {2U, 3U, 5U, 8U};
+    register unsigned int thread_index = 0;
+    register unsigned int random = 54321U;
+    unsigned int pattern, size;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__parallel_sort() test:\n");
+#endif
+
+    neda_float__init(&da_copy);
+    while (thread_index < sizeof(threads) / sizeof(threads[0]))
+    {
+      /* Runs are not equal, so the last one is longer. */
+      size = NEDA_PARALLEL_SORT_MIN_SIZE * threads[thread_index] +
+             threads[thread_index] * 7U + 3U;
+      pattern = 0;
+      while (pattern < 2U)
+      {
+        neda_float__clear(da);
+        neda_float__clear(da_copy);
+        index = 0;
+        while (index < size)
+        {
+          random = random * 1103515245U + 12345U;
+          temp_float = pattern ? (float)((random >> 8) % 16U)
+                               : (float)(random >> 8);
+          neda_float__push_back(da, temp_float);
+          neda_float__push_back(da_copy, temp_float);
+          index++;
+        }
+
+        neda_float__parallel_sort(da, threads[thread_index]);
+        neda_float__sort(da_copy);
+
+        temp_int = neda_float__size(da) == size &&
+                   !memcmp(neda_float__data(da),
+                           neda_float__data(da_copy),
+                           sizeof(float) * size);
+#if PRINT_TESTS != 0
+        printf(
+            TAB "%u threads, %-10s (%u values) same as sort: %u; Expected: %u;\n",
+            threads[thread_index],
+            pattern ? "duplicates" : "random",
+            size,
+            temp_int,
+            1U);
+#endif
+        tests_passed_temp &= temp_int == 1U;
+        pattern++;
+      }
+      thread_index++;
+    }
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__free(&da_copy);
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__radix_sort(),
+   * neda_float__radix_sort_by_integer_part() test:
+   */
+  {
+    register unsigned int random = 54321U;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__radix_sort(),\n"
+           "neda_float__radix_sort_by_integer_part() test:\n");
+#endif
+
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      random = random * 1103515245U + 12345U;
+      neda_float__push_back(
+          da,
+          ((float)((random >> 8) % 20000U) - 10000.0f) / 8.0f);
+      index++;
+    }
+
+    neda_float__radix_sort(da);
+
+    temp_int = 1;
+    index = 1;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= !(neda_float__at(da, index) < neda_float__at(da, index - 1));
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "(%u values in [-1250.0; 1250.0) range)\n"
+        TAB "First: %.3f; Last: %.3f;\n"
+        TAB "Sorted:                %u; Expected: %u;\n",
+        BIG_ARRAY_SIZE,
+        neda_float__at(da, 0),
+        neda_float__at(da, BIG_ARRAY_SIZE - 1),
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Sorting by integer part is stable, so inside of every integer
+     * part values stay in descending order after reversing.
+     */
+    index = 0;
+    while (index < BIG_ARRAY_SIZE / 2)
+    {
+      temp_float = neda_float__at(da, index);
+      *neda_float__at_ptr(da, index) =
+          neda_float__at(da, BIG_ARRAY_SIZE - 1 - index);
+      *neda_float__at_ptr(da, BIG_ARRAY_SIZE - 1 - index) = temp_float;
+      index++;
+    }
+    neda_float__radix_sort_by_integer_part(da);
+
+    temp_int = 1;
+    index = 1;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_float = neda_float__at(da, index - 1);
+      if ((int)temp_float == (int)neda_float__at(da, index))
+      {
+        temp_int &= !(temp_float < neda_float__at(da, index));
+      }
+      else
+      {
+        temp_int &= (int)temp_float < (int)neda_float__at(da, index);
+      }
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Sorted by integer part: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__set_functions(),
+   * neda_float__default_functions() test:
+   */
+  {
+    struct neda_float__functions functions;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__set_functions(),\n"
+           "neda_float__default_functions() test:\n");
+#endif
+
+    /* Array with it's own table is sorted by it's own comparator,
+     * other arrays still use global one.
+     */
+    functions = *neda_float__default_functions();
+    functions.compare = compare_greater;
+    neda_float__init(&da_copy);
+    index = 0;
+    while (index < 64U)
+    {
+      neda_float__push_back(da, (float)((index * 37U) % 64U));
+      neda_float__push_back(da_copy, (float)((index * 37U) % 64U));
+      index++;
+    }
+    neda_float__set_functions(da, &functions);
+    neda_float__sort(da);
+    neda_float__sort(da_copy);
+
+    temp_int = 1;
+    index = 1;
+    while (index < 64U)
+    {
+      temp_int &= neda_float__at(da, index - 1) > neda_float__at(da, index);
+      temp_int &= neda_float__at(da_copy, index - 1) <
+                  neda_float__at(da_copy, index);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Own table sorted in reverse, global in order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_float__set_functions(da, neda_float__default_functions());
+    neda_float__insert(da, 1, 100.0f);
+    neda_float__erase(da, 1);
+    neda_float__sort(da);
+    temp_int = 1;
+    index = 1;
+    while (index < 64U)
+    {
+      temp_int &= neda_float__at(da, index - 1) < neda_float__at(da, index);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Default table sorted in order:                %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Swap and move functions of own table are used by sorting,
+     * global ones are default. */
+    functions = *neda_float__default_functions();
+    functions.swap = swap_counted;
+    functions.move = move_counted;
+    neda_float__set_functions(da, &functions);
+    swap_calls = 0;
+    move_calls = 0;
+    neda_float__sort(da_copy);
+    temp_int = swap_calls == 0U && move_calls == 0U;
+    index = 0;
+    while (index < 64U)
+    {
+      neda_float__at_ptr(da, index)[0] = (float)((index * 37U) % 64U);
+      index++;
+    }
+    neda_float__sort(da);
+    temp_int &= swap_calls > 0U && move_calls > 0U;
+    index = 1;
+    while (index < 64U)
+    {
+      temp_int &= neda_float__at(da, index - 1) < neda_float__at(da, index);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Own swap and move functions are used:        %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__set_functions(da, 0);
+    neda_float__free(&da_copy);
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_deque_float__push_back(),
+   * neda_deque_float__push_front(),
+   * neda_deque_float__pop_back(),
+   * neda_deque_float__pop_front(),
+   * neda_deque_float__append_n(),
+   * neda_deque_float__spans(),
+   * neda_deque_float__copy_to() test:
+   */
+  {
+    struct neda_deque_float *dq = 0;
+    float values[64];
+    float *first, *second;
+    unsigned int first_size, second_size;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_deque_float__push_back(),\n"
+           "neda_deque_float__push_front(),\n"
+           "neda_deque_float__pop_back(),\n"
+           "neda_deque_float__pop_front(),\n"
+           "neda_deque_float__append_n(),\n"
+           "neda_deque_float__spans(),\n"
+           "neda_deque_float__copy_to() test:\n");
+#endif
+
+    /* Head is moved near the end of buffer, so next elements wrap
+     * around and buffer grows, while it is wrapped.
+     */
+    neda_deque_float__init(&dq);
+    neda_deque_float__reserve(dq, 16U);
+    index = 0;
+    while (index < 12U)
+    {
+      neda_deque_float__push_back(dq, (float)index);
+      index++;
+    }
+    while (neda_deque_float__size(dq) > 2U)
+    {
+      neda_deque_float__pop_front(dq);
+    }
+    index = 12U;
+    while (index < 40U)
+    {
+      neda_deque_float__push_back(dq, (float)index);
+      index++;
+    }
+    neda_deque_float__push_front(dq, 9.0f);
+    neda_deque_float__push_front(dq, 8.0f);
+
+    temp_int = neda_deque_float__size(dq) == 32U;
+    index = 0;
+    while (index < 32U)
+    {
+      temp_int &= neda_deque_float__at(dq, index) == (float)(index + 8U);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Size: %u; Capacity: %u; Front: %.1f; Back: %.1f;\n"
+        TAB "Order after wrap and growth: %u; Expected: %u;\n",
+        neda_deque_float__size(dq),
+        neda_deque_float__capacity(dq),
+        neda_deque_float__front(dq),
+        neda_deque_float__back(dq),
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Bulk append goes through the wrap point. */
+    index = 0;
+    while (index < 10U)
+    {
+      neda_deque_float__pop_front(dq);
+      neda_deque_float__pop_back(dq);
+      index++;
+    }
+    index = 0;
+    while (index < 20U)
+    {
+      values[index] = (float)(100U + index);
+      index++;
+    }
+    *neda_deque_float__at_ptr(dq, 0) = -1.0f;
+    neda_deque_float__append_n(dq, values, 20U);
+    neda_deque_float__spans(dq, &first, &first_size, &second, &second_size);
+    neda_deque_float__copy_to(dq, values);
+
+    temp_int = first_size + second_size == 32U;
+    temp_int &= second_size > 0U;
+    temp_int &= values[0] == -1.0f && values[1] == 19.0f;
+    temp_int &= values[11] == 29.0f && values[12] == 100.0f;
+    index = 0;
+    while (index < neda_deque_float__size(dq))
+    {
+      temp_int &= values[index] == neda_deque_float__at(dq, index);
+      temp_int &= values[index] == (index < first_size
+                                        ? first[index]
+                                        : second[index - first_size]);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Spans: %u + %u;\n"
+        TAB "Copied in order:             %u; Expected: %u;\n",
+        first_size,
+        second_size,
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_deque_float__clear(dq);
+    tests_passed_temp &= neda_deque_float__size(dq) == 0U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_deque_float__free(&dq);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_small_float__push_back(),
+   * neda_small_float__insert(),
+   * neda_small_float__erase(),
+   * neda_small_float__append_n(),
+   * neda_small_float__destroy() test:
+   */
+  {
+    struct neda_small_float small;
+    const float values[4] = {20.0f, 21.0f, 22.0f, 23.0f};
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_small_float__push_back(),\n"
+           "neda_small_float__insert(),\n"
+           "neda_small_float__erase(),\n"
+           "neda_small_float__append_n(),\n"
+           "neda_small_float__destroy() test:\n");
+#endif
+
+    neda_small_float__init(&small);
+    index = 0;
+    while (index < 7U)
+    {
+      neda_small_float__push_back(&small, (float)index);
+      index++;
+    }
+    neda_small_float__insert(&small, 0, -1.0f);
+    temp_int = neda_small_float__is_inline(&small);
+    temp_int &= neda_small_float__size(&small) == 8U;
+    temp_int &= neda_small_float__data(&small) == small.storage.local;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "8 elements are inline:       %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Ninth element moves array to heap. */
+    neda_small_float__push_back(&small, 7.0f);
+    neda_small_float__append_n(&small, values, 4U);
+    neda_small_float__erase(&small, 0);
+    *neda_small_float__at_ptr(&small, 0) = 100.0f;
+    temp_int = !neda_small_float__is_inline(&small);
+    temp_int &= neda_small_float__size(&small) == 12U;
+    temp_int &= neda_small_float__capacity(&small) >= 12U;
+    temp_int &= neda_small_float__at(&small, 0) == 100.0f;
+    index = 1;
+    while (index < 8U)
+    {
+      temp_int &= neda_small_float__at(&small, index) == (float)index;
+      index++;
+    }
+    temp_int &= neda_small_float__pop_back(&small) == 23.0f;
+    temp_int &= neda_small_float__at(&small, 8) == 20.0f;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Spilled to heap in order:    %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Inline values are appended to itself, while array spills. */
+    neda_small_float__clear(&small);
+    neda_small_float__destroy(&small);
+    neda_small_float__init(&small);
+    index = 0;
+    while (index < 8U)
+    {
+      neda_small_float__push_back(&small, (float)index);
+      index++;
+    }
+    neda_small_float__append_n(&small, neda_small_float__data(&small), 8U);
+    temp_int = !neda_small_float__is_inline(&small) &&
+               neda_small_float__size(&small) == 16U;
+    index = 0;
+    while (index < 16U)
+    {
+      temp_int &= neda_small_float__at(&small, index) == (float)(index % 8U);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Appended to itself:          %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_small_float__clear(&small);
+    neda_small_float__destroy(&small);
+    tests_passed_temp &= neda_small_float__is_inline(&small);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__init_allocator(),
+   * neda_arena__reset() test:
+   */
+  {
+    struct neda_arena arena;
+    struct neda_float *arena_da = 0;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__init_allocator(),\n"
+           "neda_arena__reset() test:\n");
+#endif
+
+    /* Arrays grow one after other, so arena copies them. */
+    neda_arena__init(&arena, 1024U);
+    neda_float__init_allocator(&arena_da, &arena.allocator);
+    neda_float__init_allocator(&da_copy, &arena.allocator);
+    index = 0;
+    while (index < BIG_ARRAY_SIZE / 10U)
+    {
+      neda_float__push_back(arena_da, (float)index);
+      neda_float__push_front(da_copy, (float)index);
+      index++;
+    }
+    neda_float__shrink_to_fit(arena_da);
+
+    temp_int = neda_float__size(arena_da) == BIG_ARRAY_SIZE / 10U;
+    index = 0;
+    while (index < BIG_ARRAY_SIZE / 10U)
+    {
+      temp_int &= neda_float__at(arena_da, index) == (float)index;
+      temp_int &= neda_float__at(da_copy, index) ==
+                  (float)(BIG_ARRAY_SIZE / 10U - 1U - index);
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Arena arrays keep elements: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* "free" gives memory back to arena, "reset" drops it. */
+    neda_float__free(&da_copy);
+    neda_float__free(&arena_da);
+    neda_arena__reset(&arena);
+    neda_float__init_allocator(&arena_da, &arena.allocator);
+    neda_float__push_back(arena_da, 1.5f);
+    temp_int = neda_float__at(arena_da, 0) == 1.5f;
+    temp_int &= arena.blocks && !arena.blocks->next;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Arena is reused after reset: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__free(&arena_da);
+    neda_arena__destroy(&arena);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__init_in_place(),
+   * neda_float__destroy() test:
+   */
+  {
+    struct
+    {
+      int id;
+      struct neda_float values;
+    } owner;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__init_in_place(),\n"
+           "neda_float__destroy() test:\n");
+#endif
+
+    owner.id = 7;
+    neda_float__init_in_place(&owner.values);
+    temp_int = neda_float__size(&owner.values) == 0U;
+    temp_int &= neda_float__data(&owner.values) == 0;
+    index = 0;
+    while (index < DEFAULT_CHUNK + 1U)
+    {
+      neda_float__push_front(&owner.values, (float)index);
+      index++;
+    }
+    neda_float__sort(&owner.values);
+    index = 0;
+    while (index < DEFAULT_CHUNK + 1U)
+    {
+      temp_int &= neda_float__at(&owner.values, index) == (float)index;
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Embedded array in order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_float__destroy(&owner.values);
+    temp_int = neda_float__size(&owner.values) == 0U;
+    temp_int &= neda_float__capacity(&owner.values) == 0U;
+    neda_float__push_back(&owner.values, 1.0f);
+    temp_int &= neda_float__at(&owner.values, 0) == 1.0f;
+    temp_int &= owner.id == 7;
+    neda_float__destroy(&owner.values);
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Reused after destroy:    %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__lower_bound(),
+   * neda_float__upper_bound(),
+   * neda_float__equal_range(),
+   * neda_float__insert_sorted(),
+   * neda_float__eytzinger_lower_bound() test:
+   */
+  {
+    nedasize_t first, last, linear_first, linear_last;
+    float value;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__lower_bound(),\n"
+           "neda_float__upper_bound(),\n"
+           "neda_float__equal_range(),\n"
+           "neda_float__insert_sorted(),\n"
+           "neda_float__eytzinger_lower_bound() test:\n");
+#endif
+
+    neda_float__set_default_compare_function();
+
+    /* Every even value from 0 to 198 is stored (value / 20 + 1) times,
+     * searches are checked against linear scan for all values in
+     * [-1; 200] range with step 0.5.
+     */
+    index = 0;
+    while (index < 200U)
+    {
+      temp_int = 0;
+      while (temp_int <= index / 20U)
+      {
+        neda_float__insert_sorted(da, (float)(index - index % 2U));
+        temp_int++;
+      }
+      index += 2U;
+    }
+    neda_float__init(&da_copy);
+    neda_float__eytzinger_build(da, da_copy);
+
+    temp_int = neda_float__size(da) == 550U;
+    value = -1.0f;
+    while (value <= 200.0f)
+    {
+      linear_first = 0;
+      while (linear_first < neda_float__size(da) &&
+             neda_float__at(da, linear_first) < value)
+      {
+        linear_first++;
+      }
+      linear_last = linear_first;
+      while (linear_last < neda_float__size(da) &&
+             neda_float__at(da, linear_last) == value)
+      {
+        linear_last++;
+      }
+      neda_float__equal_range(da, value, &first, &last);
+      temp_int &= first == linear_first && last == linear_last;
+      temp_int &= neda_float__lower_bound(da, value) == linear_first;
+      temp_int &= neda_float__upper_bound(da, value) == linear_last;
+      first = neda_float__eytzinger_lower_bound(da_copy, value);
+      temp_int &= linear_first == neda_float__size(da)
+                      ? first == neda_float__size(da_copy)
+                      : neda_float__at(da_copy, first) ==
+                            neda_float__at(da, linear_first);
+      value += 0.5f;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Same as linear scan: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__free(&da_copy);
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__find(),
+   * neda_float__count(),
+   * neda_float__sum(),
+   * neda_float__min(),
+   * neda_float__max() test:
+   */
+  {
+    double sum = 0.0;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__find(),\n"
+           "neda_float__count(),\n"
+           "neda_float__sum(),\n"
+           "neda_float__min(),\n"
+           "neda_float__max() test:\n");
+#endif
+
+    /* Size is not multiple of block, so tails are checked too. */
+    index = 0;
+    while (index < 1000U + 7U)
+    {
+      neda_float__push_back(da, (float)(index % 100U) - 50.0f);
+      sum += (double)(index % 100U) - 50.0;
+      index++;
+    }
+    *neda_float__at_ptr(da, 1003) = -70.0f;
+    *neda_float__at_ptr(da, 1005) = 80.0f;
+    sum += (-70.0 + 47.0) + (80.0 + 45.0);
+
+    temp_int = neda_float__find(da, -50.0f) == 0U;
+    temp_int &= neda_float__find(da, 48.0f) == 98U;
+    temp_int &= neda_float__find(da, 80.0f) == 1005U;
+    temp_int &= neda_float__find(da, 0.5f) == neda_float__size(da);
+    temp_int &= neda_float__count(da, 0.0f) == 10U;
+    temp_int &= neda_float__count(da, 6.0f) == 10U;
+    temp_int &= neda_float__min(da) == -70.0f;
+    temp_int &= neda_float__max(da) == 80.0f;
+    temp_int &= neda_float__sum(da) == sum;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Sum: %.1f; Min: %.1f; Max: %.1f;\n"
+        TAB "Same as scalar loops: %u; Expected: %u;\n",
+        neda_float__sum(da),
+        neda_float__min(da),
+        neda_float__max(da),
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__stable_sort() test: */
+  {
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__stable_sort() test:\n");
+#endif
+
+    /* Fractional part is index of element among elements with the
+       same integer part. Runs of different lengths are mixed with
+       descending runs, so galloping merges are used too. */
+    index = 0;
+    while (index < 2000U)
+    {
+      neda_float__push_back(
+          da,
+          (float)((index / 100U) % 2U ? index % 10U : 9U - index % 10U) +
+              (float)(index / 10U) / 256.0f);
+      index++;
+    }
+    neda_float__set_compare_function(compare_integer_part);
+    neda_float__stable_sort(da);
+    temp_int = 1;
+    index = 1;
+    while (index < neda_float__size(da))
+    {
+      temp_int &= neda_float__at(da, index - 1) <= neda_float__at(da, index);
+      index++;
+    }
+    /* Sorted array is one run, it is left as is. */
+    neda_float__stable_sort(da);
+    temp_int &= neda_float__at(da, 0) == 0.0f;
+    temp_int &= neda_float__at(da, 1999) == 9.0f + 199.0f / 256.0f;
+    neda_float__set_default_compare_function();
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Equal elements keep their order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__nth_element(),
+   * neda_float__partial_sort(),
+   * neda_float__top_k(),
+   * neda_float__top_k_push(),
+   * neda_float__percentile() test:
+   */
+  {
+    struct neda_float *top;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__nth_element(),\n"
+           "neda_float__partial_sort(),\n"
+           "neda_float__top_k(),\n"
+           "neda_float__top_k_push(),\n"
+           "neda_float__percentile() test:\n");
+#endif
+
+    /* Permutation of 0..999, so every rank has known value. */
+    neda_float__init(&top);
+    neda_float__set_default_compare_function();
+    index = 0;
+    while (index < 1000U)
+    {
+      neda_float__push_back(da, (float)((index * 7U) % 1000U));
+      index++;
+    }
+    neda_float__nth_element(da, 500);
+    temp_int = neda_float__at(da, 500) == 500.0f;
+    temp_int &= neda_float__max(da) == 999.0f;
+    index = 0;
+    while (index < 1000U)
+    {
+      temp_int &= index < 500U ? neda_float__at(da, index) < 500.0f
+                               : neda_float__at(da, index) >= 500.0f;
+      index++;
+    }
+    neda_float__partial_sort(da, 10);
+    index = 0;
+    while (index < 10U)
+    {
+      temp_int &= neda_float__at(da, index) == (float)index;
+      index++;
+    }
+    neda_float__top_k(da, 5, top);
+    temp_int &= neda_float__size(top) == 5U;
+    temp_int &= neda_float__at(top, 0) == 0.0f;
+    temp_int &= neda_float__at(top, 4) == 4.0f;
+    /* Streaming: heap is filled by "top_k_push" only. */
+    neda_float__clear(top);
+    index = 0;
+    while (index < 1000U)
+    {
+      neda_float__top_k_push(top, 5, neda_float__at(da, index));
+      index++;
+    }
+    neda_float__top_k_push(top, 5, -1.0f);
+    neda_float__sort(top);
+    temp_int &= neda_float__at(top, 0) == -1.0f;
+    temp_int &= neda_float__at(top, 4) == 3.0f;
+    temp_int &= neda_float__percentile(da, 50.0) == 499.5;
+    /* 989.01 is not exact in binary. */
+    temp_int &= neda_float__percentile(da, 99.0) > 989.0;
+    temp_int &= neda_float__percentile(da, 99.0) < 989.02;
+    temp_int &= neda_float__percentile(da, 100.0) == 999.0;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Median: %.2f; p99: %.2f;\n"
+        TAB "Same as after sort: %u; Expected: %u;\n",
+        neda_float__percentile(da, 50.0),
+        neda_float__percentile(da, 99.0),
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__free(&top);
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__remove_if(),
+   * neda_float__unique(),
+   * neda_float__retain_indices() test:
+   */
+  {
+    nedasize_t indices[4] = {0, 1, 2, 7};
+    float limit = 4.0f;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__remove_if(),\n"
+           "neda_float__unique(),\n"
+           "neda_float__retain_indices() test:\n");
+#endif
+
+    /* 0 0 1 1 ... 9 9 */
+    index = 0;
+    while (index < 20U)
+    {
+      neda_float__push_back(da, (float)(index / 2U));
+      index++;
+    }
+    temp_int = neda_float__remove_if(da, is_greater, &limit) == 10U;
+    temp_int &= neda_float__size(da) == 10U;
+    temp_int &= neda_float__at(da, 9) == 4.0f;
+    temp_int &= neda_float__unique(da) == 5U;
+    index = 0;
+    while (index < 5U)
+    {
+      temp_int &= neda_float__at(da, index) == (float)index;
+      index++;
+    }
+    temp_int &= neda_float__unique(da) == 0U;
+    index = 5;
+    while (index < 10U)
+    {
+      neda_float__push_back(da, (float)index);
+      index++;
+    }
+    temp_int &= neda_float__retain_indices(da, indices, 4) == 6U;
+    temp_int &= neda_float__size(da) == 4U;
+    temp_int &= neda_float__at(da, 2) == 2.0f;
+    temp_int &= neda_float__at(da, 3) == 7.0f;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Size: %u; Expected: %u;\n"
+        TAB "Kept elements are right: %u; Expected: %u;\n",
+        neda_float__size(da),
+        4U,
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__init_mapped(),
+   * neda_float__close_mapped() test:
+   */
+  {
+    struct neda_mapping mapping;
+    struct neda_float mapped;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__init_mapped(),\n"
+           "neda_float__close_mapped() test:\n");
+#endif
+
+    remove("test_neda_mapped.bin");
+    temp_int = neda_float__init_mapped(
+                   &mapped,
+                   &mapping,
+                   "test_neda_mapped.bin") == NEDA_SUCCESS;
+    temp_int &= neda_float__size(&mapped) == 0U;
+    index = 0;
+    while (temp_int && index < BIG_ARRAY_SIZE)
+    {
+      neda_float__push_back(&mapped, (float)index);
+      index++;
+    }
+    temp_int &= neda_mapping__flush(&mapping, 1) == NEDA_SUCCESS;
+    temp_int &= neda_float__close_mapped(&mapped, &mapping) == NEDA_SUCCESS;
+    /* Elements are read back from file. */
+    temp_int &= neda_float__init_mapped(
+                    &mapped,
+                    &mapping,
+                    "test_neda_mapped.bin") == NEDA_SUCCESS;
+    temp_int &= neda_mapping__advise(
+                    &mapping,
+                    POSIX_MADV_SEQUENTIAL) == NEDA_SUCCESS;
+    temp_int &= neda_float__size(&mapped) == BIG_ARRAY_SIZE;
+    index = 0;
+    while (temp_int && index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_float__at(&mapped, index) == (float)index;
+      index++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Size after reopening: %u; Expected: %u;\n"
+        TAB "Elements are kept in file: %u; Expected: %u;\n",
+        neda_float__size(&mapped),
+        BIG_ARRAY_SIZE,
+        temp_int,
+        1U);
+#endif
+    temp_int &= neda_float__close_mapped(&mapped, &mapping) == NEDA_SUCCESS;
+    remove("test_neda_mapped.bin");
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__save(),
+   * neda_float__load(),
+   * neda_float__open_mapped(),
+   * neda_float__close_snapshot() test:
+   */
+  {
+    struct neda_snapshot_header header;
+    struct neda_snapshot snapshot;
+    struct neda_float *loaded;
+    struct neda_float mapped;
+    FILE *file;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__save(),\n"
+           "neda_float__load(),\n"
+           "neda_float__open_mapped(),\n"
+           "neda_float__close_snapshot() test:\n");
+#endif
+
+    neda_float__init(&loaded);
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      neda_float__push_back(da, (float)index * 0.5f);
+      index++;
+    }
+    temp_int = neda_float__save(da, "test_neda_snapshot.bin") == NEDA_SUCCESS;
+    temp_int &= neda_float__load(loaded, "test_neda_snapshot.bin") == NEDA_SUCCESS;
+    temp_int &= neda_float__open_mapped(
+                    &mapped,
+                    &snapshot,
+                    "test_neda_snapshot.bin",
+                    1) == NEDA_SUCCESS;
+    temp_int &= neda_float__size(loaded) == BIG_ARRAY_SIZE;
+    temp_int &= neda_float__size(&mapped) == BIG_ARRAY_SIZE;
+    index = 0;
+    while (temp_int && index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_float__at(loaded, index) == neda_float__at(da, index);
+      temp_int &= neda_float__at(&mapped, index) == neda_float__at(da, index);
+      index++;
+    }
+    neda_float__close_snapshot(&mapped, &snapshot);
+
+    /* Snapshot, which is shorter than it's count says, is rejected
+     * before memory is reserved for it. */
+    file = fopen("test_neda_snapshot.bin", "rb");
+    temp_int &= file && fread(&header, sizeof(header), 1, file) == 1;
+    if (file)
+    {
+      fclose(file);
+    }
+    header.count = 0x7FFFFFFFUL;
+    file = fopen("test_neda_truncated.bin", "wb");
+    temp_int &= file && fwrite(&header, sizeof(header), 1, file) == 1 &&
+                fwrite(neda_float__data(da), sizeof(float), 4, file) == 4;
+    if (file)
+    {
+      fclose(file);
+    }
+    temp_float = (float)neda_float__capacity(loaded);
+    temp_int &= neda_float__load(loaded, "test_neda_truncated.bin") == NEDA_FAILURE;
+    temp_int &= neda_float__size(loaded) == 0U &&
+                (float)neda_float__capacity(loaded) == temp_float;
+    remove("test_neda_truncated.bin");
+    remove("test_neda_snapshot.bin");
+    /* Missing file leaves array empty. */
+    temp_int &= neda_float__load(loaded, "test_neda_snapshot.bin") == NEDA_FAILURE;
+    temp_int &= neda_float__size(loaded) == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Loaded and mapped arrays are the same: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float__free(&loaded);
+    neda_float__clear(da);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_spsc_float__try_push(),
+   * neda_spsc_float__try_pop(),
+   * neda_mpmc_float__try_push(),
+   * neda_mpmc_float__try_pop() test:
+   */
+  {
+    struct neda_spsc_float *spsc;
+    struct neda_mpmc_float *mpmc;
+    unsigned int lap = 0;
+    float value;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_spsc_float__try_push(),\n"
+           "neda_spsc_float__try_pop(),\n"
+           "neda_mpmc_float__try_push(),\n"
+           "neda_mpmc_float__try_pop() test:\n");
+#endif
+
+    neda_spsc_float__init(&spsc, 100);
+    neda_mpmc_float__init(&mpmc, 100);
+    temp_int = neda_spsc_float__capacity(spsc) == 128U &&
+               neda_mpmc_float__capacity(mpmc) == 128U;
+    /* Queues are filled and emptied several times, so indices wrap. */
+    while (lap < 3)
+    {
+      index = 0;
+      while (index < 128U)
+      {
+        temp_int &= neda_spsc_float__try_push(spsc, (float)index);
+        temp_int &= neda_mpmc_float__try_push(mpmc, (float)index);
+        index++;
+      }
+      temp_int &= !neda_spsc_float__try_push(spsc, 0.0f);
+      temp_int &= !neda_mpmc_float__try_push(mpmc, 0.0f);
+      temp_int &= neda_spsc_float__size(spsc) == 128U &&
+                  neda_mpmc_float__size(mpmc) == 128U;
+      index = 0;
+      while (index < 128U)
+      {
+        temp_int &= neda_spsc_float__try_pop(spsc, &value) &&
+                    value == (float)index;
+        temp_int &= neda_mpmc_float__try_pop(mpmc, &value) &&
+                    value == (float)index;
+        index++;
+      }
+      temp_int &= !neda_spsc_float__try_pop(spsc, &value);
+      temp_int &= !neda_mpmc_float__try_pop(mpmc, &value);
+      lap++;
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Order is kept, full and empty are detected: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_spsc_float__free(&spsc);
+    neda_mpmc_float__free(&mpmc);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_segmented_float__push_back(),
+   * neda_segmented_float__at_ptr(),
+   * neda_segmented_float__flatten() test:
+   */
+  {
+    struct neda_segmented_float *sa;
+    float *first;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_segmented_float__push_back(),\n"
+           "neda_segmented_float__at_ptr(),\n"
+           "neda_segmented_float__flatten() test:\n");
+#endif
+
+    neda_segmented_float__init(&sa);
+    temp_int = neda_segmented_float__push_back(sa, 0.0f) == 0U;
+    first = neda_segmented_float__at_ptr(sa, 0);
+    index = 1;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_segmented_float__push_back(sa, (float)index) == index;
+      index++;
+    }
+    /* Pointers are stable, elements are never moved. */
+    temp_int &= neda_segmented_float__at_ptr(sa, 0) == first;
+    temp_int &= neda_segmented_float__size(sa) == BIG_ARRAY_SIZE;
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_segmented_float__at(sa, index) == (float)index;
+      index++;
+    }
+    neda_float__push_back(da, -1.0f);
+    neda_segmented_float__flatten(sa, da);
+    temp_int &= neda_float__size(da) == BIG_ARRAY_SIZE + 1 &&
+                neda_float__at(da, 0) == -1.0f;
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_float__at(da, index + 1) == (float)index;
+      index++;
+    }
+    neda_segmented_float__clear(sa);
+    temp_int &= neda_segmented_float__size(sa) == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Elements are kept and flattened in order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_segmented_float__free(&sa);
+    neda_float__clear(da);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_soa_point__push_back(),
+   * neda_soa_point__erase(),
+   * neda_soa_point__sort() test:
+   */
+  {
+    struct neda_soa_point *points;
+    struct neda_soa_point__row row;
+    float *xs;
+    unsigned int *ids;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_soa_point__push_back(),\n"
+           "neda_soa_point__erase(),\n"
+           "neda_soa_point__sort() test:\n");
+#endif
+
+    neda_soa_point__init(&points);
+    neda_soa_point__reserve(points, 100);
+    temp_int = neda_soa_point__capacity(points) >= 100U;
+    /* "x" goes down, so sort reverses rows. */
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      row.x = (float)(BIG_ARRAY_SIZE - index);
+      row.id = index;
+      neda_soa_point__push_back(points, row);
+      index++;
+    }
+    row = neda_soa_point__pop_back(points);
+    temp_int &= row.x == 1.0f && row.id == BIG_ARRAY_SIZE - 1;
+    neda_soa_point__erase(points, 0);
+    row.x = -1.0f;
+    row.id = 0;
+    neda_soa_point__set(points, 0, row);
+    temp_int &= neda_soa_point__size(points) == BIG_ARRAY_SIZE - 2;
+    temp_int &= neda_soa_point__at(points, 1).id == 2U;
+
+    neda_soa_point__sort(points, point_x_less);
+    xs = neda_soa_point__x(points);
+    ids = neda_soa_point__id(points);
+    temp_int &= xs[0] == -1.0f && ids[0] == 0U;
+    index = 1;
+    while (index < BIG_ARRAY_SIZE - 2)
+    {
+      /* Every "id" is moved together with it's "x". */
+      temp_int &= xs[index] == (float)(index + 1) &&
+                  ids[index] == BIG_ARRAY_SIZE - index - 1;
+      index++;
+    }
+    neda_soa_point__clear(points);
+    temp_int &= neda_soa_point__size(points) == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Columns are kept together: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_soa_point__free(&points);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_float__make_heap(),
+   * neda_float__heap_push(),
+   * neda_float__heap_pop(),
+   * neda_iheap_float__decrease_key() test:
+   */
+  {
+    struct neda_iheap_float *heap;
+    struct neda_float *sorted;
+    nedasize_t handles[100];
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_float__make_heap(),\n"
+           "neda_float__heap_push(),\n"
+           "neda_float__heap_pop(),\n"
+           "neda_iheap_float__decrease_key() test:\n");
+#endif
+
+    /* Heap should give elements in order of "sort". */
+    neda_float__init(&sorted);
+    index = 0;
+    while (index < 1000U)
+    {
+      temp_float = (float)((index * 7919U) % 1000U) / 4.0f;
+      neda_float__push_back(da, temp_float);
+      neda_float__push_back(sorted, temp_float);
+      index++;
+    }
+    neda_float__make_heap(da);
+    neda_float__sort(sorted);
+    temp_int = neda_float__is_heap(da);
+    neda_float__heap_push(da, 1000.0f);
+    neda_float__heap_push(da, -1000.0f);
+    temp_int &= neda_float__is_heap(da) &&
+                neda_float__heap_top(da) == -1000.0f;
+    temp_int &= neda_float__heap_pop(da) == -1000.0f;
+    index = 0;
+    while (index < 1000U)
+    {
+      temp_int &= neda_float__heap_pop(da) == neda_float__at(sorted, index);
+      index++;
+    }
+    temp_int &= neda_float__heap_pop(da) == 1000.0f &&
+                neda_float__size(da) == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Heap pops in sort order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    /* Values with odd index are decreased by 100 and go to the
+     * front of indexed heap. */
+    neda_iheap_float__init(&heap);
+    index = 0;
+    while (index < 100U)
+    {
+      handles[index] = neda_iheap_float__push(heap, (float)index + 100.0f);
+      index++;
+    }
+    index = 1;
+    while (index < 100U)
+    {
+      neda_iheap_float__decrease_key(
+          heap,
+          handles[index],
+          (float)index);
+      index += 2;
+    }
+    temp_int = neda_iheap_float__size(heap) == 100U &&
+               neda_iheap_float__top_handle(heap) == handles[1] &&
+               neda_iheap_float__top(heap) == 1.0f &&
+               neda_iheap_float__value(heap, handles[3]) == 3.0f;
+    index = 0;
+    while (index < 100U)
+    {
+      temp_float = index < 50U ? (float)(index * 2 + 1)
+                               : (float)((index - 50U) * 2 + 100U);
+      temp_int &= neda_iheap_float__pop(heap) == temp_float;
+      index++;
+    }
+    temp_int &= !neda_iheap_float__contains(heap, handles[0]);
+    /* Handles of popped values are reused. */
+    temp_int &= neda_iheap_float__push(heap, 5.0f) < 100U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Indexed heap pops in sort order: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_iheap_float__free(&heap);
+    neda_float__free(&sorted);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* NEDA_BODY_IMPLEMENTATION_CMP test: */
+  {
+    struct neda_float__functions functions;
+    struct neda_float_desc *desc;
+    float values[1000];
+    register unsigned int random = 777U;
+    unsigned int step = 0;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nNEDA_BODY_IMPLEMENTATION_CMP test:\n");
+#endif
+
+    /* Array with "*_a > *_b" built in should be ordered like array
+     * with the same comparison in compare function. Functions table
+     * of built in array gives ascending order, it should be ignored.
+     */
+    index = 0;
+    while (index < 1000U)
+    {
+      random = random * 1103515245U + 12345U;
+      values[index] = (float)((random >> 8) % 300U);
+      index++;
+    }
+    functions = *neda_float__default_functions();
+    functions.compare = compare_greater;
+    neda_float__init(&da_copy);
+    neda_float__set_functions(da_copy, &functions);
+    neda_float_desc__init(&desc);
+    neda_float_desc__set_functions(desc, neda_float_desc__default_functions());
+
+    temp_int = 1;
+    while (step < 3U)
+    {
+      neda_float__clear(da_copy);
+      neda_float_desc__clear(desc);
+      neda_float__append_n(da_copy, values, 1000U);
+      neda_float_desc__append_n(desc, values, 1000U);
+      switch (step)
+      {
+      case 0:
+        neda_float__sort(da_copy);
+        neda_float_desc__sort(desc);
+        break;
+      case 1:
+        neda_float__quick_sort(da_copy);
+        neda_float_desc__quick_sort(desc);
+        break;
+      default:
+        neda_float__stable_sort(da_copy);
+        neda_float_desc__stable_sort(desc);
+        break;
+      }
+      temp_int &= !memcmp(neda_float__data(da_copy),
+                          neda_float_desc__data(desc),
+                          sizeof(float) * 1000U);
+      step++;
+    }
+    temp_int &= neda_float_desc__at(desc, 0) >= neda_float_desc__at(desc, 999U);
+    temp_int &= neda_float_desc__lower_bound(desc, 150.0f) ==
+                neda_float__lower_bound(da_copy, 150.0f);
+    temp_int &= neda_float_desc__at(
+                    desc,
+                    neda_float_desc__lower_bound(desc, 150.0f)) <= 150.0f;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "sort, quick_sort, stable_sort, lower_bound: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_float__clear(da_copy);
+    neda_float_desc__clear(desc);
+    neda_float__append_n(da_copy, values, 1000U);
+    neda_float_desc__append_n(desc, values, 1000U);
+    neda_float__make_heap(da_copy);
+    neda_float_desc__make_heap(desc);
+    temp_int = neda_float_desc__is_heap(desc);
+    neda_float_desc__heap_push(desc, 1000.0f);
+    neda_float__heap_push(da_copy, 1000.0f);
+    temp_int &= neda_float_desc__heap_top(desc) == 1000.0f;
+    while (neda_float_desc__size(desc))
+    {
+      temp_int &= neda_float_desc__heap_pop(desc) ==
+                  neda_float__heap_pop(da_copy);
+    }
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Heap functions:                             %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+
+    neda_float_desc__free(&desc);
+    neda_float__free(&da_copy);
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
+  /* neda_bitset__push_back(),
+   * neda_bitset__find_next(),
+   * neda_bitset__rank(),
+   * neda_bitset__select() test:
+   */
+  {
+    struct neda_bitset bits, other;
+    unsigned int count = 0;
+
+    tests_count++;
+    tests_passed_temp = 1;
+#if PRINT_TESTS != 0
+    printf("\nneda_bitset__push_back(),\n"
+           "neda_bitset__find_next(),\n"
+           "neda_bitset__rank(),\n"
+           "neda_bitset__select() test:\n");
+#endif
+
+    /* Every 7th bit is set, every 3rd bit of "other" is set. */
+    neda_bitset__init(&bits);
+    neda_bitset__init(&other);
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      neda_bitset__push_back(&bits, index % 7 == 0);
+      index++;
+    }
+    neda_bitset__resize(&other, BIG_ARRAY_SIZE);
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      neda_bitset__set(&other, index);
+      if (index % 3)
+      {
+        neda_bitset__reset(&other, index);
+      }
+      index++;
+    }
+    temp_int = neda_bitset__size(&bits) == BIG_ARRAY_SIZE &&
+               neda_bitset__test(&bits, 700) &&
+               !neda_bitset__test(&bits, 701) &&
+               neda_bitset__count(&bits) == (BIG_ARRAY_SIZE + 6) / 7;
+
+    /* find_next visits every set bit. */
+    index = neda_bitset__find_next(&bits, 0);
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= index == count * 7;
+      count++;
+      index = neda_bitset__find_next(&bits, index + 1);
+    }
+    temp_int &= count == (BIG_ARRAY_SIZE + 6) / 7;
+
+    neda_bitset__build_rank(&bits);
+    index = 0;
+    while (index < BIG_ARRAY_SIZE)
+    {
+      temp_int &= neda_bitset__rank(&bits, index) == (index + 6) / 7;
+      index += 13;
+    }
+    index = 0;
+    while (index < count)
+    {
+      temp_int &= neda_bitset__select(&bits, index) == index * 7;
+      index++;
+    }
+    temp_int &= neda_bitset__select(&bits, count) == BIG_ARRAY_SIZE;
+
+    /* Word-wise operations: multiples of 21 are left. */
+    neda_bitset__and(&bits, &other);
+    temp_int &= neda_bitset__count(&bits) == (BIG_ARRAY_SIZE + 20) / 21;
+    neda_bitset__or(&bits, &other);
+    temp_int &= neda_bitset__count(&bits) == (BIG_ARRAY_SIZE + 2) / 3;
+    neda_bitset__andnot(&bits, &other);
+    temp_int &= neda_bitset__count(&bits) == 0U;
+    neda_bitset__xor(&bits, &other);
+    temp_int &= neda_bitset__count(&bits) == (BIG_ARRAY_SIZE + 2) / 3;
+
+    /* Bits after size are cleared by shrinking. */
+    neda_bitset__resize(&bits, 10);
+    neda_bitset__resize(&bits, 100);
+    temp_int &= neda_bitset__count(&bits) == 4U;
+    neda_bitset__clear(&bits);
+    temp_int &= neda_bitset__size(&bits) == 0U;
+#if PRINT_TESTS != 0
+    printf(
+        TAB "Bits are found, ranked and selected: %u; Expected: %u;\n",
+        temp_int,
+        1U);
+#endif
+    tests_passed_temp &= temp_int == 1U;
+
+    neda_bitset__destroy(&bits);
+    neda_bitset__destroy(&other);
+
+    if (tests_passed_temp)
+    {
+      tests_passed++;
+    }
+#if ASSERT_FAILS != 0
+    assert(tests_passed_temp);
+#endif
+  }
+
   neda_float__free(&da);
 
   printf(
@@ -0,0 +1,104 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NEDA_MMAP
+#define nedasize_t size_t
+#include "../include/neda.h"
+
+/* Array is bigger than 2^32 bytes, so every index above 2^32 checks,
+ * that nothing is truncated to 32 bits. File is sparse, so test needs
+ * disk space only for touched pages. */
+#define LARGE_FILE "test_neda_large.bin"
+#define LARGE_SIZE ((size_t)5000000000UL)
+#define LARGE_CHUNK 4096
+
+NEDA_HEADER_POSTFIX(byte, unsigned char)
+NEDA_BODY_IMPLEMENTATION_POSTFIX(byte, unsigned char, LARGE_CHUNK)
+NEDA_NUMERIC_HEADER_POSTFIX(byte, unsigned char, unsigned long)
+NEDA_NUMERIC_BODY_IMPLEMENTATION_POSTFIX(byte, unsigned char, unsigned long)
+NEDA_MAPPED_HEADER_POSTFIX(byte, unsigned char)
+NEDA_MAPPED_BODY_IMPLEMENTATION_POSTFIX(byte, unsigned char)
+
+static int check(const char *_name, const int _passed)
+{
+  printf("  %-40s %s\n", _name, _passed ? "passed" : "FAILED");
+  return _passed;
+}
+
+int main(void)
+{
+  struct neda_mapping mapping;
+  struct neda_byte da;
+  const size_t high = ((size_t)1 << 32) + 7;
+  FILE *file;
+  int passed = 1;
+
+  printf("neda large array testing (%lu bytes):\n", (unsigned long)LARGE_SIZE);
+
+  file = fopen(LARGE_FILE, "wb");
+  if (!file || fclose(file) || truncate(LARGE_FILE, (off_t)LARGE_SIZE))
+  {
+    printf("  can not create %s\n", LARGE_FILE);
+    return 1;
+  }
+  if (neda_byte__init_mapped(&da, &mapping, LARGE_FILE) != NEDA_SUCCESS)
+  {
+    printf("  can not map %s\n", LARGE_FILE);
+    remove(LARGE_FILE);
+    return 1;
+  }
+  neda_byte__set_default_functions();
+
+  passed &= check("size", neda_byte__size(&da) == LARGE_SIZE);
+
+  *neda_byte__at_ptr(&da, high) = 42;
+  *neda_byte__at_ptr(&da, high - ((size_t)1 << 32)) = 7;
+  passed &= check(
+      "at above 2^32",
+      neda_byte__at(&da, high) == 42 &&
+          neda_byte__at(&da, high - ((size_t)1 << 32)) == 7);
+
+  neda_byte__push_back(&da, 1);
+  neda_byte__push_back(&da, 2);
+  passed &= check(
+      "push_back",
+      neda_byte__size(&da) == LARGE_SIZE + 2 &&
+          neda_byte__at(&da, neda_byte__size(&da) - 1) == 2);
+  neda_byte__pop_back(&da);
+  passed &= check(
+      "pop_back",
+      neda_byte__size(&da) == LARGE_SIZE + 1 &&
+          neda_byte__at(&da, neda_byte__size(&da) - 1) == 1);
+
+  neda_byte__insert(&da, LARGE_SIZE - 1, 3);
+  passed &= check(
+      "insert",
+      neda_byte__at(&da, LARGE_SIZE - 1) == 3 &&
+          neda_byte__at(&da, LARGE_SIZE + 1) == 1);
+  neda_byte__erase(&da, LARGE_SIZE - 1);
+  passed &= check(
+      "erase",
+      neda_byte__size(&da) == LARGE_SIZE + 1 &&
+          neda_byte__at(&da, LARGE_SIZE - 1) == 0 &&
+          neda_byte__at(&da, neda_byte__size(&da) - 1) == 1);
+
+  passed &= check("find", neda_byte__find(&da, 42) == high);
+  passed &= check("sum", neda_byte__sum(&da) == 42 + 7 + 1);
+
+  passed &= check(
+      "close_mapped",
+      neda_byte__close_mapped(&da, &mapping) == NEDA_SUCCESS);
+  passed &= check(
+      "reopen",
+      neda_byte__init_mapped(&da, &mapping, LARGE_FILE) == NEDA_SUCCESS &&
+          neda_byte__size(&da) == LARGE_SIZE + 1 &&
+          neda_byte__at(&da, high) == 42 &&
+          neda_byte__at(&da, neda_byte__size(&da) - 1) == 1);
+  neda_byte__close_mapped(&da, &mapping);
+  remove(LARGE_FILE);
+
+  printf("%s\n", passed ? "All tests passed" : "Some tests FAILED");
+  return !passed;
+}
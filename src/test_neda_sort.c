@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <search.h>
 #include "../include/neda.h"
 